@@ -2,17 +2,52 @@ HEADERS += $$PWD/src/securitydata/ingdibabackend.h \
         $$PWD/src/dividenddata/dividenddataupdateworker.h \
         $$PWD/src/dividenddata/divvydiary.h \
         $$PWD/src/ingdibautils.h \
+        $$PWD/src/loggingcategories.h \
+        $$PWD/src/timestamputils.h \
         $$PWD/src/securitydata/abstractdatabackend.h \
+        $$PWD/src/securitydata/backenddescriptor.h \
         $$PWD/src/securitydata/chartdatacalculator.h \
+        $$PWD/src/securitydata/chartseries.h \
+        $$PWD/src/securitydata/intradayseriescache.h \
+        $$PWD/src/securitydata/jsonstreamreader.h \
+        $$PWD/src/securitydata/quoteservice.h \
         $$PWD/src/newsdata/ingdibanews.h \
+        $$PWD/src/newsdata/newscontentfilter.h \
         $$PWD/src/newsdata/onvistanews.h \
+        $$PWD/src/network/networkservice.h \
+        $$PWD/src/network/pendingreply.h \
+        $$PWD/src/network/quotebatcher.h \
+        $$PWD/src/network/responsecache.h \
+        $$PWD/src/network/responseprocessor.h \
+        $$PWD/src/network/retrypolicy.h \
+        $$PWD/src/network/tlssessionstore.h \
+        $$PWD/src/network/requestscheduler.h \
+        $$PWD/src/watchlistdata/watchlistmodel.h \
+        $$PWD/src/watchlistdata/watchlistsortmodel.h \
         $$PWD/src/constants.h
 
 SOURCES += $$PWD/src/securitydata/ingdibabackend.cpp \
             $$PWD/src/dividenddata/dividenddataupdateworker.cpp \
             $$PWD/src/dividenddata/divvydiary.cpp \
             $$PWD/src/ingdibautils.cpp \
+            $$PWD/src/loggingcategories.cpp \
+            $$PWD/src/timestamputils.cpp \
             $$PWD/src/securitydata/abstractdatabackend.cpp \
             $$PWD/src/securitydata/chartdatacalculator.cpp \
+            $$PWD/src/securitydata/chartseries.cpp \
+            $$PWD/src/securitydata/intradayseriescache.cpp \
+            $$PWD/src/securitydata/jsonstreamreader.cpp \
+            $$PWD/src/securitydata/quoteservice.cpp \
             $$PWD/src/newsdata/ingdibanews.cpp \
-            $$PWD/src/newsdata/onvistanews.cpp
\ No newline at end of file
+            $$PWD/src/newsdata/newscontentfilter.cpp \
+            $$PWD/src/newsdata/onvistanews.cpp \
+            $$PWD/src/network/networkservice.cpp \
+            $$PWD/src/network/pendingreply.cpp \
+            $$PWD/src/network/quotebatcher.cpp \
+            $$PWD/src/network/requestscheduler.cpp \
+            $$PWD/src/network/responsecache.cpp \
+            $$PWD/src/network/responseprocessor.cpp \
+            $$PWD/src/network/retrypolicy.cpp \
+            $$PWD/src/network/tlssessionstore.cpp \
+            $$PWD/src/watchlistdata/watchlistmodel.cpp \
+            $$PWD/src/watchlistdata/watchlistsortmodel.cpp
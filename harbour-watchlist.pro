@@ -33,6 +33,9 @@ HEADERS += \
 
 DEFINES += VERSION_NUMBER=\\\"$$(VERSION_NUMBER)\\\"
 
+# debug messages are compiled out of release builds - warnings are still logged
+CONFIG(release, debug|release): DEFINES += QT_NO_DEBUG_OUTPUT
+
 OTHER_FILES += rpm/harbour-watchlist.changes.in \
     rpm/harbour-watchlist.spec \
     rpm/harbour-watchlist.yaml \
@@ -32,8 +32,11 @@ SilicaFlickable {
     property string extRefId
     property int screenHeight : 0
     property var chartDataMap : ({})
+    // request id of the latest fetch per chart type - results of older fetches are dropped
+    property var chartRequestIdMap : ({})
     property bool isActive : false
     readonly property string loadingLabel: qsTr("Loading...")
+    readonly property string noDataLabel: qsTr("No chart data available")
 
     contentHeight: stockChartsColumn.height
 
@@ -41,20 +44,85 @@ SilicaFlickable {
         return getSecurityDataBackend(watchlistSettings.dataBackend);
     }
 
-    function fetchPricesForChartHandler(result, type) {
-        chartDataMap[type] = JSON.parse(result);
+    function fetchPricesForChart(chartType) {
+        var requestId = 0;
+        // only called for this request - a negative appendedCount marks a new series
+        var chartSeriesHandler = function (chartSeries, type, appendedCount) {
+            if (appendedCount < 0) {
+                fetchPricesForChartHandler(requestId, chartSeries, type);
+            } else {
+                fetchPricesForChartAppendedHandler(requestId, chartSeries, appendedCount, type);
+            }
+        };
+        networkService.beginRequestScope(Constants.REQUEST_SCOPE_STOCK_OVERVIEW);
+        requestId = getDataBackend().requestPricesForChart(extRefId, chartType, chartSeriesHandler);
+        chartRequestIdMap[chartType] = requestId;
+        networkService.endRequestScope();
+    }
+
+    function fetchPricesForChartHandler(requestId, chartSeries, type) {
+        if (chartRequestIdMap[type] !== requestId) {
+            return;
+        }
+        chartDataMap[type] = chartSeries;
+        if (chartSeries.count === 0) {
+            // e.g. the security has no chart for the period - do not show loading forever
+            var chart = chartForType(type);
+            if (chart) {
+                chart.graphBodyText = noDataLabel;
+            }
+        }
         if (!triggerChartDataDownloadOnEntering()) {
             // manually triggered chart download
             repaintCharts();
         }
     }
 
-    function updateStockChart(response, chart) {
-        if (response && response.data) {
-            chart.minY = (response.min / 1.0);
-            chart.maxY = (response.max / 1.0);
-            chart.setPoints(response.data);
-            chart.fractionDigits = response.fractionDigits;
+    function fetchPricesForChartAppendedHandler(requestId, chartSeries, appendedCount, type) {
+        if (chartRequestIdMap[type] !== requestId) {
+            return;
+        }
+        var previousSeries = chartDataMap[type];
+        if (!previousSeries || previousSeries.count !== (chartSeries.count - appendedCount)) {
+            // the previous series is not known here - same as a new series
+            fetchPricesForChartHandler(requestId, chartSeries, type);
+            return;
+        }
+
+        chartDataMap[type] = chartSeries;
+        // only the intraday series is refreshed incrementally
+        if (isActive && appendedCount > 0 && type === Constants.CHART_TYPE_INTRDAY) {
+            intradayStockChart.minY = chartSeries.min;
+            intradayStockChart.maxY = chartSeries.max;
+            intradayStockChart.appendPoints(chartSeries, appendedCount);
+            intradayStockChart.fractionDigits = chartSeries.fractionDigits;
+        }
+    }
+
+    function chartForType(type) {
+        switch (type) {
+        case Constants.CHART_TYPE_INTRDAY:
+            return intradayStockChart;
+        case Constants.CHART_TYPE_MONTH:
+            return lastMonthStockChart;
+        case Constants.CHART_TYPE_3_MONTHS:
+            return lastThreeMonthStockChart;
+        case Constants.CHART_TYPE_YEAR:
+            return lastYearStockChart;
+        case Constants.CHART_TYPE_3_YEARS:
+            return lastThreeYearsStockChart;
+        case Constants.CHART_TYPE_5_YEARS:
+            return lastFiveYearsStockChart;
+        }
+        return null;
+    }
+
+    function updateStockChart(chartSeries, chart) {
+        if (chartSeries) {
+            chart.minY = chartSeries.min;
+            chart.maxY = chartSeries.max;
+            chart.setPoints(chartSeries);
+            chart.fractionDigits = chartSeries.fractionDigits;
         }
     }
 
@@ -71,6 +139,7 @@ SilicaFlickable {
             updateStockChart(chartDataMap[Constants.CHART_TYPE_3_MONTHS], lastThreeMonthStockChart)
             updateStockChart(chartDataMap[Constants.CHART_TYPE_YEAR], lastYearStockChart)
             updateStockChart(chartDataMap[Constants.CHART_TYPE_3_YEARS], lastThreeYearsStockChart)
+            updateStockChart(chartDataMap[Constants.CHART_TYPE_5_YEARS], lastFiveYearsStockChart)
         }
     }
 
@@ -80,12 +149,12 @@ SilicaFlickable {
         running: false
         repeat: false
         onTriggered: {
-            var dataBackend = getDataBackend();
-            dataBackend.fetchPricesForChart(extRefId, Constants.CHART_TYPE_INTRDAY)
-            dataBackend.fetchPricesForChart(extRefId, Constants.CHART_TYPE_MONTH);
-            dataBackend.fetchPricesForChart(extRefId, Constants.CHART_TYPE_3_MONTHS);
-            dataBackend.fetchPricesForChart(extRefId, Constants.CHART_TYPE_YEAR);
-            dataBackend.fetchPricesForChart(extRefId, Constants.CHART_TYPE_3_YEARS);
+            fetchPricesForChart(Constants.CHART_TYPE_INTRDAY);
+            fetchPricesForChart(Constants.CHART_TYPE_MONTH);
+            fetchPricesForChart(Constants.CHART_TYPE_3_MONTHS);
+            fetchPricesForChart(Constants.CHART_TYPE_YEAR);
+            fetchPricesForChart(Constants.CHART_TYPE_3_YEARS);
+            fetchPricesForChart(Constants.CHART_TYPE_5_YEARS);
         }
     }
 
@@ -112,7 +181,7 @@ SilicaFlickable {
             onClicked: {
                 Functions.log("chart intraday clicked !")
                 intradayStockChart.graphBodyText = loadingLabel
-                getDataBackend().fetchPricesForChart(extRefId, Constants.CHART_TYPE_INTRDAY);
+                fetchPricesForChart(Constants.CHART_TYPE_INTRDAY);
             }
         }
 
@@ -126,7 +195,7 @@ SilicaFlickable {
             onClicked: {
                 Functions.log("chart month clicked !")
                 lastMonthStockChart.graphBodyText = loadingLabel
-                getDataBackend().fetchPricesForChart(extRefId, Constants.CHART_TYPE_MONTH);
+                fetchPricesForChart(Constants.CHART_TYPE_MONTH);
             }
         }
 
@@ -140,7 +209,7 @@ SilicaFlickable {
             onClicked: {
                 Functions.log("chart 3 month clicked !")
                 lastThreeMonthStockChart.graphBodyText = loadingLabel
-                getDataBackend().fetchPricesForChart(extRefId, Constants.CHART_TYPE_3_MONTHS);
+                fetchPricesForChart(Constants.CHART_TYPE_3_MONTHS);
             }
         }
 
@@ -154,7 +223,7 @@ SilicaFlickable {
             onClicked: {
                 Functions.log("chart year clicked !")
                 lastYearStockChart.graphBodyText = loadingLabel
-                getDataBackend().fetchPricesForChart(extRefId, Constants.CHART_TYPE_YEAR);
+                fetchPricesForChart(Constants.CHART_TYPE_YEAR);
             }
         }
 
@@ -168,7 +237,21 @@ SilicaFlickable {
             onClicked: {
                 Functions.log("chart year clicked !")
                 lastThreeYearsStockChart.graphBodyText = loadingLabel
-                getDataBackend().fetchPricesForChart(extRefId, Constants.CHART_TYPE_3_YEARS);
+                fetchPricesForChart(Constants.CHART_TYPE_3_YEARS);
+            }
+        }
+
+        StockChart {
+            id: lastFiveYearsStockChart
+            visible: getDataBackend().isChartTypeSupported(Constants.CHART_TYPE_5_YEARS);
+            graphTitle: qsTr("5 Years")
+            chartType: Constants.CHART_TYPE_5_YEARS
+            graphHeight: screenHeight * 0.15625
+            showTrendTriangle: true
+            onClicked: {
+                Functions.log("chart year clicked !")
+                lastFiveYearsStockChart.graphBodyText = loadingLabel
+                fetchPricesForChart(Constants.CHART_TYPE_5_YEARS);
             }
         }
     }
@@ -183,6 +266,7 @@ SilicaFlickable {
             lastThreeMonthStockChart.axisYUnit = currencyUnit;
             lastYearStockChart.axisYUnit = currencyUnit;
             lastThreeYearsStockChart.axisYUnit = currencyUnit;
+            lastFiveYearsStockChart.axisYUnit = currencyUnit;
 
             var infoLines = {};
             infoLines.referencePrice = {};
@@ -210,9 +294,8 @@ SilicaFlickable {
             lastThreeMonthStockChart.infoLines = infoLines;
             lastYearStockChart.infoLines = infoLines;
             lastThreeYearsStockChart.infoLines = infoLines;
+            lastFiveYearsStockChart.infoLines = infoLines;
 
-            // connect signal slot for chart update
-            getDataBackend().fetchPricesForChartAvailable.connect(fetchPricesForChartHandler)
             if (triggerChartDataDownloadOnEntering()) {
                 fetchPricesForChartTimer.start();
             }
@@ -221,11 +304,6 @@ SilicaFlickable {
         Functions.log("completed")
     }
 
-    Component.onDestruction: {
-        Functions.log("disconnecting signal")
-        getDataBackend().fetchPricesForChartAvailable.disconnect(fetchPricesForChartHandler)
-    }
-
     onIsActiveChanged: {
         repaintCharts();
     }
@@ -80,7 +80,9 @@ SilicaFlickable {
         onTriggered: {
             loading = true;
             var newsBackend = getNewsBackend()
+            networkService.beginRequestScope(Constants.REQUEST_SCOPE_STOCK_OVERVIEW);
             newsBackend.searchStockNews(isin)
+            networkService.endRequestScope();
         }
     }
 
@@ -18,6 +18,7 @@
 import QtQuick 2.2
 import QtQuick.LocalStorage 2.0
 import Sailfish.Silica 1.0
+import harbour.watchlist 1.0
 
 // QTBUG-34418
 import "."
@@ -32,9 +33,13 @@ import "../components/thirdparty"
 SilicaFlickable {
     id: watchlistViewFlickable
 
-    property real maxChange: 0.0
+    property real maxChange: stocksModel.maxChange
     property bool loaded : false
     property int watchlistId
+    // latest quote request - results of older requests are dropped
+    property int quoteRequestId: 0
+    // security ids of the requested quotes by extRefId - the quotes are persisted without a lookup per quote
+    property var quoteSecurityIds: ({})
 
     anchors.fill: parent
     contentHeight: watchlistColumn.height
@@ -52,32 +57,41 @@ SilicaFlickable {
     function connectSlots() {
         console.log("connect - slots");
         var dataBackend = getSecurityDataBackend(watchlistSettings.dataBackend);
-        dataBackend.quoteResultAvailable.connect(quoteResultHandler);
         dataBackend.requestError.connect(errorResultHandler);
     }
 
     function disconnectSlots() {
         console.log("disconnect - slots");
         var dataBackend = getSecurityDataBackend(watchlistSettings.dataBackend);
-        dataBackend.quoteResultAvailable.disconnect(quoteResultHandler);
         dataBackend.requestError.disconnect(errorResultHandler);
     }
 
-    function quoteResultHandler(result) {
-      var jsonResult = JSON.parse(result.toString())
-      console.log("json result from data backend was: " +result)
-      for (var i = 0; i < jsonResult.length; i++)   {
-          var stockQuote = jsonResult[i];
-          var stock = Database.loadStockBy(watchlistId, '' + stockQuote.extRefId)
-          if (stock) {
+    function quoteResultHandler(requestId, quotes) {
+      if (requestId !== quoteRequestId) {
+          return;
+      }
+      console.log("received " + quotes.length + " quotes from data backend")
+      for (var i = 0; i < quotes.length; i++)   {
+          var stockQuote = quotes[i];
+          var securityId = quoteSecurityIds['' + stockQuote.extRefId];
+          if (securityId !== undefined) {
               // copy id
-              stockQuote.id = stock.id;
+              stockQuote.id = securityId;
               // persist
               Database.persistStockData(stockQuote, watchlistId)
           }
       }
-      reloadAllStocks()
+      // only the rows of the batch are updated - the positions are calculated when all batches have arrived
+      stocksModel.updateQuotes(quotes)
+    }
+
+    // all batches have arrived - the quotes were already shown by quoteResultHandler
+    function quotesCompletedHandler(requestId, itemStatus) {
+      if (requestId !== quoteRequestId) {
+          return;
+      }
       loaded = true;
+      reloadAllStocks()
 
       Database.loadTriggeredAlarms(watchlistId, true).forEach(stockAlarmNotification.createMinimumAlarm);
       Database.loadTriggeredAlarms(watchlistId, false).forEach(stockAlarmNotification.createMaximumAlarm);
@@ -94,12 +108,8 @@ SilicaFlickable {
 
     function reloadAllStocks() {
         console.log("reloading all stocks for watchlist " + watchlistId);
-        var sortOrder = (watchlistSettings.sortingOrder === Constants.SORTING_ORDER_BY_CHANGE ? Database.SORT_BY_CHANGE_DESC : Database.SORT_BY_NAME_ASC);
-        var stocks = Database.loadAllStockData(watchlistId, sortOrder);
-
-
-        // stockQuotePage.
-        maxChange = Functions.calculateMaxChange(stocks)
+        // sorted by the model
+        var stocks = Database.loadAllStockData(watchlistId, Database.SORT_BY_NAME_ASC);
 
         var triggerUpdateQuotes = false;
         // when stockmodel is not empty and the number of stocks in the db is different -> stock has been added
@@ -115,15 +125,9 @@ SilicaFlickable {
             connectSlots();
         }
 
-        var depotCurrentValue = Functions.calculateAttributeSumValue(stocks, Functions.cbPositionCurrentValue);
-
-        var currencySymbol = "";
-        stocksModel.clear()
-        for (var i = 0; i < stocks.length; i++) {
-            stocks[i].portfolioShare = Functions.calculatePercentage(stocks[i].positionCurrentValue, depotCurrentValue);
-            stocksModel.append(stocks[i]);
-            currencySymbol = stocks[i].currencySymbol;
-        }
+        // only the rows with changed values are updated - the model also calculates the portfolio share
+        stocksModel.update(stocks);
+        var currencySymbol = (stocks.length > 0 ? stocks[stocks.length - 1].currencySymbol : "");
 
         stockQuotesHeader.description = Functions.calculatePortfolioPerformanceString(stocks, currencySymbol);
 
@@ -139,49 +143,40 @@ SilicaFlickable {
 
         var numberOfQuotes = stocksModel.count
 
-        var stocks = []
+        var securities = []
+        var securityIds = {}
         for (var i = 0; i < numberOfQuotes; i++) {
-            stocks.push(stocksModel.get(i).extRefId)
+            var security = stocksModel.get(i)
+            securities.push({ backendId: watchlistSettings.dataBackend, extRefId: security.extRefId })
+            securityIds['' + security.extRefId] = security.id
         }
+        quoteSecurityIds = securityIds
 
         if (numberOfQuotes > 0) {
             loaded = false;
-            getSecurityDataBackend(watchlistSettings.dataBackend).searchQuote(stocks.join(','));
+            var requestId = quoteService.fetchQuotes(securities, function (quotes) {
+                quoteResultHandler(requestId, quotes);
+            }, function (itemStatus) {
+                quotesCompletedHandler(requestId, itemStatus);
+            });
+            quoteRequestId = requestId;
         }
     }
 
     // TODO consolidate methods updateReferencePriceInModel and updateNotesInModel
     function updateReferencePriceInModel(securityId, referencePrice) {
         Functions.log("[WatchlistView] Received updateReferencePriceInModel " + securityId + ", " + referencePrice);
-        var numberOfQuotes = stocksModel.count
-        for (var i = 0; i < numberOfQuotes; i++) {
-            if (stocksModel.get(i).id === securityId) {
-                stocksModel.get(i).referencePrice = referencePrice;
-                Functions.log("[WatchlistView] Updated reference price in model!");
-            }
-        }
+        stocksModel.setValue(securityId, "referencePrice", referencePrice);
     }
 
     function updatePiecesInModel(securityId, pieces) {
         Functions.log("[WatchlistView] Received updatePiecesInModel " + securityId + ", " + pieces);
-        var numberOfQuotes = stocksModel.count
-        for (var i = 0; i < numberOfQuotes; i++) {
-            if (stocksModel.get(i).id === securityId) {
-                stocksModel.get(i).pieces = pieces;
-                Functions.log("[WatchlistView] Updated pieces in model!");
-            }
-        }
+        stocksModel.setValue(securityId, "pieces", pieces);
     }
 
     function updateNotesInModel(securityId, notes) {
         Functions.log("[WatchlistView] Received updateNotesInModel " + securityId + ", " + notes);
-        var numberOfQuotes = stocksModel.count
-        for (var i = 0; i < numberOfQuotes; i++) {
-            if (stocksModel.get(i).id === securityId) {
-                stocksModel.get(i).notes = notes;
-                Functions.log("[WatchlistView] Updated notes in model!");
-            }
-        }
+        stocksModel.setValue(securityId, "notes", notes);
     }
 
     AppNotification {
@@ -228,8 +223,9 @@ SilicaFlickable {
 
             clip: true
 
-            model: ListModel {
+            model: WatchlistSortModel {
                 id: stocksModel
+                sortOrder: watchlistSettings.sortingOrder
             }
 
             delegate: ListItem {
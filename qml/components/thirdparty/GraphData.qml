@@ -57,29 +57,30 @@ Item {
 
     property string axisYUnit: ""
 
-    property var points: []
+    // ChartSeries - the timestamps and values are read by index
+    property var points: null
+    property int pointCount: points ? points.count : 0
     onPointsChanged: {
-        noData = (points.length == 0);
+        noData = (!points || points.count == 0);
     }
     property bool noData: true
 
-    function setPoints(data) {
-        if (!data) return;
+    function setPoints(series) {
+        if (!series) return;
 
-        var pointMaxY = 0;
-        if (data.length > 0) {
-            minX = data[0].x;
-            maxX = data[data.length-1].x;
+        var count = series.count;
+        if (count > 0) {
+            minX = series.timestamp(0);
+            maxX = series.timestamp(count - 1);
         }
-        data.forEach(function(point) {
-            if (point.y > pointMaxY) {
-                pointMaxY = point.y
-            }
-        });
-        points = data;
         if (scale) {
+            var pointMaxY = 0;
+            for (var i = 0; i < count; i++) {
+                pointMaxY = Math.max(pointMaxY, series.value(i));
+            }
             maxY = pointMaxY * 1.20;
         }
+        points = series;
         // TODO hier wird die achsenzahl gesteuert
         intraday = ((maxX - minX) <= 86400); // 1 day - only show time
 
@@ -88,6 +89,27 @@ Item {
         canvas.requestPaint();
     }
 
+    // the series extends the shown points - only the appended points are scanned
+    function appendPoints(series, appendedCount) {
+        if (!series || !points || (series.count - appendedCount) !== pointCount) {
+            setPoints(series);
+            return;
+        }
+
+        var count = series.count;
+        maxX = series.timestamp(count - 1);
+        if (scale) {
+            var pointMaxY = maxY / 1.20;
+            for (var i = count - appendedCount; i < count; i++) {
+                pointMaxY = Math.max(pointMaxY, series.value(i));
+            }
+            maxY = pointMaxY * 1.20;
+        }
+        points = series;
+
+        canvas.requestPaint();
+    }
+
     function createYLabel(value) {
         var v = value;
         if (valueConverter) {
@@ -221,7 +243,7 @@ Item {
                 //renderTarget: Canvas.FramebufferObject
                 //renderStrategy: Canvas.Threaded
 
-                property real stepX: (parent.width / (points.length- 2)) // - lineWidth
+                property real stepX: (parent.width / (pointCount - 2)) // - lineWidth
                 property real stepY: (maxY-minY)/(height-2)
 
                 function drawTrendTriangle(ctx, startValue, endValue) {
@@ -301,7 +323,7 @@ Item {
                     // console.log("width: " + parent.width)
                     // console.log("maxY", maxY, "minY", minY, "height", height, "StepY", stepY);
 
-                    var end = points.length;
+                    var end = pointCount;
 
                     if (end > 0) {
                         drawGrid(ctx);
@@ -313,7 +335,7 @@ Item {
                         drawInfoLine(ctx, infoLines.referencePrice);
 
                         if (showTrendTriangle) {
-                            drawTrendTriangle(ctx, points[0].y, points[end - 1].y);
+                            drawTrendTriangle(ctx, points.value(0), points.value(end - 1));
                         }
                     }
 
@@ -325,8 +347,9 @@ Item {
                     var x = -stepX;
                     var valueSum = 0;
                     for (var i = 0; i < end; i++) {
-                        valueSum += points[i].y;
-                        var y = (height - Math.floor((points[i].y - minY) / stepY) - 1) // + (minY * stepY);
+                        var value = points.value(i);
+                        valueSum += value;
+                        var y = (height - Math.floor((value - minY) / stepY) - 1) // + (minY * stepY);
 //                        console.log(" x : " + x + ", y : " + y);
                         if (i === 0) {
                             ctx.moveTo(x, y);
@@ -341,7 +364,7 @@ Item {
                     if (end > 0) {
                         var lastValue = valueSum;
                         if (!root.valueTotal) {
-                            lastValue = points[end-1].y;
+                            lastValue = points.value(end - 1);
                         }
                         if (lastValue) {
                             labelLastValue.text = root.createLastYLabel(lastValue)+root.axisY.units;
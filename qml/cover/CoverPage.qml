@@ -29,6 +29,10 @@ CoverBackground {
     id: coverPage
     property int watchlistId: Constants.WATCHLIST_1 // TODO so far hard code - maybe make it configurable
     property bool loading : false;
+    // latest quote request - results of older requests are dropped
+    property int quoteRequestId: 0
+    // security ids of the requested quotes by extRefId - the quotes are persisted without a lookup per quote
+    property var quoteSecurityIds: ({})
 
     function reloadAllStocks() {
         coverModel.clear()
@@ -55,34 +59,51 @@ CoverBackground {
         // listView.model.get(index)
         var stocks = Database.loadAllStockData(watchlistId,
                                                Database.SORT_BY_CHANGE_ASC)
-        var stockExtRefIds = []
+        var securities = []
+        var securityIds = {}
         for (var i = 0; i < stocks.length; i++) {
-            stockExtRefIds.push(stocks[i].extRefId)
+            securities.push({ backendId: watchlistSettings.dataBackend, extRefId: stocks[i].extRefId })
+            securityIds['' + stocks[i].extRefId] = stocks[i].id
         }
+        quoteSecurityIds = securityIds
 
         if (stocks.length > 0) {
-            var dataBackend = getSecurityDataBackend(watchlistSettings.dataBackend);
-            dataBackend.searchQuote(stockExtRefIds.join(','))
+            var requestId = quoteService.fetchQuotesInBackground(securities, function (quotes) {
+                quoteResultHandler(requestId, quotes)
+            }, function (itemStatus) {
+                quotesCompletedHandler(requestId, itemStatus)
+            })
+            quoteRequestId = requestId
         } else {
             loading = false;
         }
     }
 
-    function quoteResultHandler(result) {
-        var jsonResult = JSON.parse(result.toString())
-        Functions.log("[CoverPage] - quoteResultHandler json result from backend was: " + result)
-        for (var i = 0; i < jsonResult.length; i++) {
-            var stockQuote = jsonResult[i]
-            var stock = Database.loadStockBy(watchlistId, '' + stockQuote.extRefId)
-            if (stock) {
+    function quoteResultHandler(requestId, quotes) {
+        if (requestId !== quoteRequestId) {
+            return;
+        }
+        Functions.log("[CoverPage] - quoteResultHandler received " + quotes.length + " quotes from backend")
+        for (var i = 0; i < quotes.length; i++) {
+            var stockQuote = quotes[i]
+            var securityId = quoteSecurityIds['' + stockQuote.extRefId]
+            if (securityId !== undefined) {
                 // copy id
-                stockQuote.id = stock.id
+                stockQuote.id = securityId
                 // persist
                 Database.persistStockData(stockQuote, watchlistId)
             }
         }
-        reloadAllStocks()
+    }
+
+    // all batches have arrived - the quotes were already shown by quoteResultHandler
+    function quotesCompletedHandler(requestId, itemStatus) {
+        if (requestId !== quoteRequestId) {
+            return;
+        }
         loading = false;
+        // the cover shows the largest changes of all securities - sorted once when all batches have arrived
+        reloadAllStocks()
 
         Database.loadTriggeredAlarms(watchlistId, true).forEach(stockAlarmNotification.createMinimumAlarm);
         Database.loadTriggeredAlarms(watchlistId, false).forEach(stockAlarmNotification.createMaximumAlarm);
@@ -261,7 +282,6 @@ CoverBackground {
 
         Component.onCompleted: {
             var dataBackend = getSecurityDataBackend(watchlistSettings.dataBackend);
-            dataBackend.quoteResultAvailable.connect(quoteResultHandler)
             dataBackend.requestError.connect(errorResultHandler)
             app.securityAdded.connect(securityAdded);
             reloadAllStocks()
@@ -74,6 +74,20 @@ ApplicationWindow {
         return Functions.determineChangeColor(change, Theme.primaryColor);
     }
 
+    Connections {
+        target: Qt.application
+        onStateChanged: {
+            // connections are closed while the app is in the background
+            if (Qt.application.state === Qt.ApplicationActive) {
+                watchlist.preconnect(watchlistSettings.dataBackend);
+            }
+        }
+    }
+
+    Component.onCompleted: {
+        watchlist.preconnect(watchlistSettings.dataBackend);
+    }
+
     Component {
         id: overviewPage
         OverviewPage {
@@ -28,6 +28,9 @@ var BACKEND_EUROINVESTOR = 0;
 var BACKEND_MOSCOW_EXCHANGE = 1;
 var BACKEND_ING_DIBA = 2;
 
+// tag of the requests that are aborted when the stock overview page is left
+var REQUEST_SCOPE_STOCK_OVERVIEW = "stockOverview";
+
 var DEFAULT_FRACTION_DIGITS = 2;
 var CURRENCY_FRACTION_DIGITS = 4;
 var MEDIUM_FRACTION_DIGITS = 4;
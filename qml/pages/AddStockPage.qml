@@ -30,24 +30,27 @@ import "../components/thirdparty"
 Page {
     id: stockSearchPage
     property int watchlistId
+    // results of older searches are dropped
+    property int searchRequestId: 0
 
     allowedOrientations: Orientation.All
 
     function connectSlots() {
         Functions.log("AddStockPage - connecting - slots")
         var dataBackend = getSecurityDataBackend(watchlistSettings.dataBackend);
-        dataBackend.searchResultAvailable.connect(searchResultHandler);
         dataBackend.requestError.connect(errorResultHandler);
     }
 
     function disconnectSlots() {
         Functions.log("AddStockPage - disconnecting - slots")
         var dataBackend = getSecurityDataBackend(watchlistSettings.dataBackend);
-        dataBackend.searchResultAvailable.disconnect(searchResultHandler);
         dataBackend.requestError.disconnect(errorResultHandler);
     }
 
-    function searchResultHandler(result) {
+    function searchResultHandler(requestId, result) {
+      if (requestId !== searchRequestId) {
+          return;
+      }
       var jsonResult = JSON.parse(result.toString())
       Functions.log("json result from backend was: " + result)
 
@@ -101,7 +104,11 @@ Page {
                 repeat: false
                 onTriggered: {
                     searchResultListModel.clear()
-                    getSecurityDataBackend(watchlistSettings.dataBackend).searchName(searchField.text);
+                    var dataBackend = getSecurityDataBackend(watchlistSettings.dataBackend);
+                    var requestId = dataBackend.requestSearchName(searchField.text, function (result) {
+                        searchResultHandler(requestId, result);
+                    });
+                    searchRequestId = requestId;
                 }
             }
 
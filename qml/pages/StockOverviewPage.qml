@@ -5,6 +5,7 @@ import Sailfish.Silica 1.0
 import Nemo.Notifications 1.0
 
 import "../components"
+import "../js/constants.js" as Constants
 import "../js/functions.js" as Functions
 
 Page {
@@ -16,6 +17,13 @@ Page {
 
     property int activeTabId: 0
 
+    onStatusChanged: {
+        // charts and news of the stock are not needed anymore when the page is left
+        if (status === PageStatus.Deactivating && _navigation === PageNavigation.Back) {
+            networkService.abortRequests(Constants.REQUEST_SCOPE_STOCK_OVERVIEW);
+        }
+    }
+
     function openTab(tabId) {
 
         activeTabId = tabId
@@ -38,10 +38,17 @@ const char MOSCOW_EXCHANGE_API_SEARCH[]
     = "http://iss.moex.com/iss/securities.json?q=%1&group_by_filter=stock_shares&limit=15%2";
 const char MOSCOW_EXCHANGE_QUOTE[] = "https://iss.moex.com/iss/engines/stock/markets/shares/boards/"
                                      "TQBR/securities.json?securities=%1%2";
-// can fetch max 100 entries at a time - so about a quarter
-const char MOSCOW_EXCHANGE_API_CLOSE_PRICES[]
-    = "https://iss.moex.com/iss/history/engines/stock/markets/shares/boards/TQBR/securities/"
-      "%1.json?from=%2%3";
+// candles aggregated by the server - %2 is the first day, %3 the interval (minutes, 24 = day, 7 = week, 31 = month)
+// can fetch max 500 candles at a time - longer ranges are fetched in pages (MOSCOW_EXCHANGE_CANDLES_START)
+const char MOSCOW_EXCHANGE_API_CANDLES[] = "https://iss.moex.com/iss/engines/stock/markets/shares/boards/TQBR/"
+                                           "securities/%1/candles.json?from=%2&interval=%3";
+// only the blocks and columns that are parsed are transferred - %1 (and %2) are the comma separated column names
+const char MOSCOW_EXCHANGE_SEARCH_PROJECTION[] = "&iss.meta=off&iss.only=securities&securities.columns=%1";
+const char MOSCOW_EXCHANGE_QUOTE_PROJECTION[]
+    = "&iss.meta=off&iss.only=securities,marketdata&securities.columns=%1&marketdata.columns=%2";
+const char MOSCOW_EXCHANGE_CANDLES_PROJECTION[] = "&iss.meta=off&iss.only=candles&candles.columns=%1";
+// offset of the first candle of a page
+const char MOSCOW_EXCHANGE_CANDLES_START[] = "&start=%1";
 
 // Ing-Diba
 const char ING_DIBA_API_SEARCH[] = "https://api.wertpapiere.ing.de/suche-autocomplete/autocomplete?query=%1";
@@ -61,5 +68,6 @@ const char EXCHANGE_RATES[] = "https://commander.commerzbank.com/efx-rates/payme
 const char NETWORK_REPLY_PROPERTY_CHART_TYPE[] = "chartType";
 const char NETWORK_REPLY_PROPERTY_EXT_REF_ID[] = "extRefId";
 const char NETWORK_REPLY_PROPERTY_EXCHANGE_RATE[] = "exchangeRateMap";
+const char NETWORK_REPLY_PROPERTY_REQUEST_ID[] = "requestId";
 
 #endif // CONSTANTS_H
@@ -26,45 +26,48 @@
 #include <QUrlQuery>
 
 #include "../constants.h"
+#include "../loggingcategories.h"
 #include "dividenddataupdateworker.h"
 
 DividendDataUpdateWorker::DividendDataUpdateWorker(QObject *parent)
     : QThread(parent) {
-    qDebug() << "Initializing Dividend Data Update worker";
+    qCDebug(lcDividends) << "Initializing Dividend Data Update worker";
     database = QSqlDatabase::addDatabase("QSQLITE");
 
     if (database.databaseName().isEmpty()) {
         QQmlApplicationEngine engine;
-        qDebug() << "path : " << engine.offlineStoragePath();
+        qCDebug(lcDb) << "path : " << engine.offlineStoragePath();
 
         // https://lists.qt-project.org/pipermail/interest/2016-March/021316.html
         QString path(engine.offlineStoragePath() + "/Databases/"
                      + QCryptographicHash::hash(APP_NAME, QCryptographicHash::Md5).toHex() + ".sqlite");
 
-        qDebug() << "path : " << path;
+        qCDebug(lcDb) << "path : " << path;
 
         database.setDatabaseName(path);
 
-        qDebug() << "is valid : " << database.isValid();
-        qDebug() << "open error : " << database.isOpenError();
+        qCDebug(lcDb) << "is valid : " << database.isValid();
+        qCDebug(lcDb) << "open error : " << database.isOpenError();
     }
 }
 
 DividendDataUpdateWorker::~DividendDataUpdateWorker() {
-    qDebug() << "DividendDataUpdateWorker::destroy";
+    qCDebug(lcDividends) << "DividendDataUpdateWorker::destroy";
     database.close();
 }
 
-void DividendDataUpdateWorker::setParameters(const QJsonDocument &jsonDocument,
+void DividendDataUpdateWorker::setParameters(const QByteArray &dividendData,
                                              const QMap<QString, QVariant> exchangeRateMap) {
-    this->jsonDocument = jsonDocument;
+    this->dividendData = dividendData;
     this->exchangeRateMap = exchangeRateMap;
 }
 
 void DividendDataUpdateWorker::performUpdate() {
     int rows = 0;
+    // the dividend data of all securities is large - parse it here and not on the gui thread
+    const QJsonDocument jsonDocument = QJsonDocument::fromJson(dividendData);
     if (jsonDocument.isObject()) {
-        qDebug() << "removing old dividend data";
+        qCDebug(lcDividends) << "removing old dividend data";
         executeQuery(QString("DELETE FROM dividends"), QMap<QString, QVariant>());
 
         QJsonObject rootObject = jsonDocument.object();
@@ -72,7 +75,6 @@ void DividendDataUpdateWorker::performUpdate() {
 
         QVariant empty;
 
-        // TODO run in worker
         foreach (const QJsonValue &dividendsEntry, dividendsArray) {
             QJsonObject dividendsObject = dividendsEntry.toObject();
 
@@ -132,7 +134,7 @@ void DividendDataUpdateWorker::executeQuery(const QString &queryString, const QM
         }
 
         if (!query.exec()) {
-            qDebug() << "SQL Statement Error" << query.lastError();
+            qCWarning(lcDb) << "SQL Statement Error" << query.lastError();
         } else {
             database.commit();
         }
@@ -140,7 +142,7 @@ void DividendDataUpdateWorker::executeQuery(const QString &queryString, const QM
 
         // qDebug() << " executed query : " << queryString;
     } else {
-        qDebug() << "Cant open DB";
+        qCWarning(lcDb) << "Cant open DB";
     }
 }
 
@@ -38,7 +38,7 @@ class DividendDataUpdateWorker : public QThread {
 public:
     explicit DividendDataUpdateWorker(QObject *parent = nullptr);
     ~DividendDataUpdateWorker() override;
-    void setParameters(const QJsonDocument &jsonDocument, const QMap<QString, QVariant> exchangeRateMap);
+    void setParameters(const QByteArray &dividendData, const QMap<QString, QVariant> exchangeRateMap);
 
 signals:
     void updateCompleted(int);
@@ -48,7 +48,7 @@ protected:
 
 private:
     QSqlDatabase database;
-    QJsonDocument jsonDocument;
+    QByteArray dividendData;
     QMap<QString, QVariant> exchangeRateMap;
 
     void performUpdate();
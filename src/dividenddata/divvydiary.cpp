@@ -16,6 +16,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "divvydiary.h"
+#include "../loggingcategories.h"
 #include "../constants.h"
 
 #include <QDebug>
@@ -24,20 +25,20 @@
 #include <QJsonObject>
 #include <QUrl>
 
-DivvyDiary::DivvyDiary(QNetworkAccessManager *manager, QObject *parent)
+DivvyDiary::DivvyDiary(NetworkService *networkService, QObject *parent)
     : QObject(parent) {
-    qDebug() << "Initializing DivvyDiary ...";
-    this->manager = manager;
+    qCDebug(lcDividends) << "Initializing DivvyDiary ...";
+    this->networkService = networkService;
 
     connect(&dividendDataUpdateWorker, SIGNAL(updateCompleted(int)), this, SLOT(handleDividendDataUpdateCompleted(int)));
 }
 
 DivvyDiary::~DivvyDiary() {
-    qDebug() << "Shutting down DivvyDiary ...";
+    qCDebug(lcDividends) << "Shutting down DivvyDiary ...";
 }
 
 void DivvyDiary::handleDividendDataUpdateCompleted(int rows) {
-    qDebug() << "DivvyDiary::handleDividendDataUpdateCompleted - rows : " << rows;
+    qCDebug(lcDividends) << "DivvyDiary::handleDividendDataUpdateCompleted - rows : " << rows;
     emit fetchDividendDatesResultAvailable(rows);
 }
 
@@ -46,14 +47,14 @@ void DivvyDiary::fetchDividendDates() {
 }
 
 void DivvyDiary::fetchExchangeRates() {
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(EXCHANGE_RATES)));
+    PendingReply *reply = executeGetRequest(QUrl(QString(EXCHANGE_RATES)));
 
     connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(handleFetchExchangeRates()));
     connect(reply, SIGNAL(finished()), this, SLOT(handleFetchExchangeRates()));
 }
 
 void DivvyDiary::fetchDividendData(const QMap<QString, QVariant> exchangeRateMap) {
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(DIVVYDIARY_DIVIDENDS)));
+    PendingReply *reply = executeGetRequest(QUrl(QString(DIVVYDIARY_DIVIDENDS)));
     reply->setProperty(NETWORK_REPLY_PROPERTY_EXCHANGE_RATE, QVariant(exchangeRateMap));
     connect(reply,
             SIGNAL(error(QNetworkReply::NetworkError)),
@@ -63,12 +64,15 @@ void DivvyDiary::fetchDividendData(const QMap<QString, QVariant> exchangeRateMap
 }
 
 void DivvyDiary::handleFetchExchangeRates() {
-    qDebug() << "DivvyDiary::handleFetchExchangeRates";
+    qCDebug(lcDividends) << "DivvyDiary::handleFetchExchangeRates";
 
     QMap<QString, QVariant> exchangeRateMap;
 
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        return;
+    }
     if (reply->error() != QNetworkReply::NoError) {
         // if fetching the exchange rates fail - fetch dividend data anyway
         fetchDividendData(exchangeRateMap);
@@ -90,8 +94,8 @@ void DivvyDiary::handleFetchExchangeRates() {
 }
 
 void DivvyDiary::handleFetchDividendDates() {
-    qDebug() << "DivvyDiary::handleFetchDividendDates";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcDividends) << "DivvyDiary::handleFetchDividendDates";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
@@ -100,22 +104,23 @@ void DivvyDiary::handleFetchDividendDates() {
     while (this->dividendDataUpdateWorker.isRunning()) {
         this->dividendDataUpdateWorker.requestInterruption();
     }
-    this->dividendDataUpdateWorker.setParameters(QJsonDocument::fromJson(reply->readAll()),
+    this->dividendDataUpdateWorker.setParameters(reply->readAll(),
                                                  reply->property(NETWORK_REPLY_PROPERTY_EXCHANGE_RATE).toMap());
     this->dividendDataUpdateWorker.start();
 }
 
-QNetworkReply *DivvyDiary::executeGetRequest(const QUrl &url) {
-    qDebug() << "DivvyDiary::executeGetRequest " << url;
+PendingReply *DivvyDiary::executeGetRequest(const QUrl &url) {
+    qCDebug(lcDividends) << "DivvyDiary::executeGetRequest " << url;
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::UserAgentHeader, USER_AGENT);
 
-    return manager->get(request);
+    // bulk download - must not delay the requests of the visible page
+    return networkService->get(request, RequestScheduler::BACKGROUND);
 }
 
 void DivvyDiary::handleRequestError(QNetworkReply::NetworkError error) {
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    qWarning() << "DivvyDiary::handleRequestError:" << static_cast<int>(error) << reply->errorString()
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
+    qCWarning(lcDividends) << "DivvyDiary::handleRequestError:" << static_cast<int>(error) << reply->errorString()
                << reply->readAll();
 
     emit requestError("Return code: " + QString::number(static_cast<int>(error)) + " - " + reply->errorString());
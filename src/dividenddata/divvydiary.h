@@ -18,16 +18,16 @@
 #ifndef DIVVYDIARY_H
 #define DIVVYDIARY_H
 
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
 
+#include "../network/networkservice.h"
 #include "dividenddataupdateworker.h"
 
 class DivvyDiary : public QObject {
     Q_OBJECT
 public:
-    explicit DivvyDiary(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    explicit DivvyDiary(NetworkService *networkService, QObject *parent = nullptr);
     ~DivvyDiary() override;
     Q_INVOKABLE void fetchDividendDates();
 
@@ -38,8 +38,8 @@ signals:
     void dividendDataUpdateSuccessful(const QVariantList &result);
 
 private:
-    QNetworkAccessManager *manager;
-    QNetworkReply *executeGetRequest(const QUrl &url);
+    NetworkService *networkService;
+    PendingReply *executeGetRequest(const QUrl &url);
 
     // worker - separate thread since expensive
     DividendDataUpdateWorker dividendDataUpdateWorker;
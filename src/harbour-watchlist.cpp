@@ -27,7 +27,9 @@
 #include <QtQml>
 
 #include "watchlist.h"
+#include "loggingcategories.h"
 #include "constants.h"
+#include "watchlistdata/watchlistsortmodel.h"
 
 void migrateLocalStorage()
 {
@@ -43,13 +45,13 @@ void migrateLocalStorage()
 
     QString dbname = QString(QCryptographicHash::hash((APP_NAME), QCryptographicHash::Md5).toHex());
 
-    qDebug() << "dbname: " + dbname;
+    qCDebug(lcDb) << "dbname: " + dbname;
 
     QString pathOld = QString("/%1/%1/QML/OfflineStorage/Databases/").arg(APP_NAME);
     QString pathNew = QString("/%1/%2/QML/OfflineStorage/Databases/").arg(ORGANISATION, APP_NAME);
 
-    qDebug() << "pathOld : " << pathOld;
-    qDebug() << "pathNew : " << pathNew;
+    qCDebug(lcDb) << "pathOld : " << pathOld;
+    qCDebug(lcDb) << "pathNew : " << pathNew;
 
     // The old LocalStorage database
     QFile oldDb(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) +  pathOld + dbname + ".sqlite");
@@ -73,6 +75,8 @@ int main(int argc, char *argv[]) {
     app->setOrganizationName(ORGANISATION); // needed for Sailjail
     app->setApplicationName(APP_NAME);
 
+    qmlRegisterType<WatchlistSortModel>("harbour.watchlist", 1, 0, "WatchlistSortModel");
+
     QScopedPointer<QQuickView> view(SailfishApp::createView());
 
     QQmlContext *context = view.data()->rootContext();
@@ -88,6 +92,8 @@ int main(int argc, char *argv[]) {
     IngDibaBackend *ingDibaBackend = watchlist.getIngDibaBackend();
     context->setContextProperty("ingDibaBackend", ingDibaBackend);
 
+    context->setContextProperty("quoteService", watchlist.getQuoteService());
+
     EuroinvestorMarketDataBackend *euroinvestorMarketDataBackend = watchlist.getEuroinvestorMarketDataBackend();
     context->setContextProperty("euroinvestorMarketDataBackend", euroinvestorMarketDataBackend);
 
@@ -95,6 +101,8 @@ int main(int argc, char *argv[]) {
 
     context->setContextProperty("divvyDiaryBackend", watchlist.getDivvyDiaryBackend());
 
+    context->setContextProperty("networkService", watchlist.getNetworkService());
+
     context->setContextProperty("applicationVersion", QString(VERSION_NUMBER));
 
     view->setSource(SailfishApp::pathTo("qml/harbour-watchlist.qml"));
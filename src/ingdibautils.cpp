@@ -1,11 +1,10 @@
 #include "ingdibautils.h"
-
-#include <QDebug>
+#include "timestamputils.h"
 
 QDateTime IngDibaUtils::convertTimestampToLocalTimestamp(const QString &utcDateTimeString, const QTimeZone &timeZone) {
-    QDateTime dt = QDateTime::fromString(utcDateTimeString, Qt::ISODate);
-    dt.setTimeZone(timeZone);
-    qDebug() << "dt : " << dt << "using timezone : " << timeZone;
-    QDateTime localDateTime = dt.toLocalTime();
-    return localDateTime;
+    return TimestampUtils::convertToLocalDateTime(utcDateTimeString, TimeZoneOffsetCache::forTimeZone(timeZone));
+}
+
+QDateTime IngDibaUtils::convertTimestampToLocalTimestamp(const QString &utcDateTimeString) {
+    return TimestampUtils::convertToLocalDateTime(utcDateTimeString, TimeZoneOffsetCache::local());
 }
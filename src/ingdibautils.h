@@ -25,7 +25,10 @@ class IngDibaUtils {
 public:
     IngDibaUtils() = default;
 
+    // the timestamp is interpreted as wall clock time of the time zone - the designator is ignored
     static QDateTime convertTimestampToLocalTimestamp(const QString &utcDateTimeString, const QTimeZone &timeZone);
+    // same as above for the system time zone
+    static QDateTime convertTimestampToLocalTimestamp(const QString &utcDateTimeString);
 };
 
 #endif // ING_DIBA_UTILS_H
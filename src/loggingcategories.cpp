@@ -0,0 +1,31 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "loggingcategories.h"
+
+#ifdef QT_NO_DEBUG_OUTPUT
+#define WATCHLIST_LOGGING_SEVERITY QtWarningMsg
+#else
+#define WATCHLIST_LOGGING_SEVERITY QtDebugMsg
+#endif
+
+Q_LOGGING_CATEGORY(lcNetwork, "watchlist.network", WATCHLIST_LOGGING_SEVERITY)
+Q_LOGGING_CATEGORY(lcParse, "watchlist.parse", WATCHLIST_LOGGING_SEVERITY)
+Q_LOGGING_CATEGORY(lcDb, "watchlist.db", WATCHLIST_LOGGING_SEVERITY)
+Q_LOGGING_CATEGORY(lcChart, "watchlist.chart", WATCHLIST_LOGGING_SEVERITY)
+Q_LOGGING_CATEGORY(lcNews, "watchlist.news", WATCHLIST_LOGGING_SEVERITY)
+Q_LOGGING_CATEGORY(lcDividends, "watchlist.dividends", WATCHLIST_LOGGING_SEVERITY)
@@ -0,0 +1,32 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LOGGING_CATEGORIES_H
+#define LOGGING_CATEGORIES_H
+
+#include <QLoggingCategory>
+
+// Release builds define QT_NO_DEBUG_OUTPUT - qCDebug is compiled out and only warnings are enabled by default.
+// Info messages can be enabled at runtime, e.g. QT_LOGGING_RULES="watchlist.network.info=true"
+Q_DECLARE_LOGGING_CATEGORY(lcNetwork)
+Q_DECLARE_LOGGING_CATEGORY(lcParse)
+Q_DECLARE_LOGGING_CATEGORY(lcDb)
+Q_DECLARE_LOGGING_CATEGORY(lcChart)
+Q_DECLARE_LOGGING_CATEGORY(lcNews)
+Q_DECLARE_LOGGING_CATEGORY(lcDividends)
+
+#endif // LOGGING_CATEGORIES_H
@@ -16,7 +16,9 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "euroinvestormarketdatabackend.h"
+#include "../loggingcategories.h"
 #include "../constants.h"
+#include "../timestamputils.h"
 
 #include <QDateTime>
 #include <QDebug>
@@ -25,10 +27,10 @@
 #include <QJsonObject>
 #include <QUrl>
 
-EuroinvestorMarketDataBackend::EuroinvestorMarketDataBackend(QNetworkAccessManager *manager, QObject *parent)
+EuroinvestorMarketDataBackend::EuroinvestorMarketDataBackend(NetworkService *networkService, QObject *parent)
     : QObject(parent) {
-    qDebug() << "Initializing Euroinvestor Market Data Backend...";
-    this->manager = manager;
+    qCDebug(lcParse) << "Initializing Euroinvestor Market Data Backend...";
+    this->networkService = networkService;
 
     // Index
     // DE
@@ -87,19 +89,10 @@ EuroinvestorMarketDataBackend::EuroinvestorMarketDataBackend(QNetworkAccessManag
 }
 
 EuroinvestorMarketDataBackend::~EuroinvestorMarketDataBackend() {
-    qDebug() << "Shutting down Euroinvestor Backend...";
+    qCDebug(lcParse) << "Shutting down Euroinvestor Backend...";
     marketDataId2ExtRefId.clear();
 }
 
-QNetworkReply *EuroinvestorMarketDataBackend::executeGetRequest(const QUrl &url) {
-    qDebug() << "AbstractDataBackend::executeGetRequest " << url;
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, MIME_TYPE_JSON);
-    request.setHeader(QNetworkRequest::UserAgentHeader, USER_AGENT);
-
-    return manager->get(request);
-}
-
 QString EuroinvestorMarketDataBackend::getMarketDataExtRefId(const QString &marketDataId) {
     if (marketDataId2ExtRefId.contains(marketDataId)) {
         return marketDataId2ExtRefId[marketDataId];
@@ -109,8 +102,8 @@ QString EuroinvestorMarketDataBackend::getMarketDataExtRefId(const QString &mark
 }
 
 void EuroinvestorMarketDataBackend::lookupMarketData(const QString &marketDataIds) {
-    qDebug() << "EuroinvestorMarketDataBackend::lookupMarketData";
-    QNetworkReply *reply = executeGetRequest(QUrl(API_MARKET_DATA + marketDataIds));
+    qCDebug(lcParse) << "EuroinvestorMarketDataBackend::lookupMarketData";
+    PendingReply *reply = networkService->getBatched(API_MARKET_DATA, marketDataIds.split(","));
 
     connect(reply,
             SIGNAL(error(QNetworkReply::NetworkError)),
@@ -120,8 +113,8 @@ void EuroinvestorMarketDataBackend::lookupMarketData(const QString &marketDataId
 }
 
 void EuroinvestorMarketDataBackend::handleLookupMarketDataFinished() {
-    qDebug() << "EuroinvestorMarketDataBackend::handleLookupMarketDataFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcParse) << "EuroinvestorMarketDataBackend::handleLookupMarketDataFinished";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
@@ -131,10 +124,10 @@ void EuroinvestorMarketDataBackend::handleLookupMarketDataFinished() {
 }
 
 QString EuroinvestorMarketDataBackend::processMarketDataResult(QByteArray marketDataResult) {
-    qDebug() << "EuroinvestorMarketDataBackend::processMarketDataResult";
+    qCDebug(lcParse) << "EuroinvestorMarketDataBackend::processMarketDataResult";
     QJsonDocument jsonDocument = QJsonDocument::fromJson(marketDataResult);
     if (!jsonDocument.isArray()) {
-        qDebug() << "not a json array!";
+        qCDebug(lcParse) << "not a json array!";
     }
 
     QJsonArray responseArray = jsonDocument.array();
@@ -156,7 +149,7 @@ QString EuroinvestorMarketDataBackend::processMarketDataResult(QByteArray market
         resultObject.insert("changeRelative", rootObject.value("changeInPercentage"));
 
         QJsonValue jsonUpdatedAt = rootObject.value("updatedAt");
-        QDateTime updatedAtLocalTime = convertUTCDateTimeToLocalDateTime(jsonUpdatedAt.toString());
+        QDateTime updatedAtLocalTime = TimestampUtils::convertUtcToLocalDateTime(jsonUpdatedAt.toString());
         resultObject.insert("quoteTimestamp", convertToDatabaseDateTimeFormat(updatedAtLocalTime));
 
         resultObject.insert("lastChangeTimestamp", convertToDatabaseDateTimeFormat(QDateTime::currentDateTime()));
@@ -171,22 +164,13 @@ QString EuroinvestorMarketDataBackend::processMarketDataResult(QByteArray market
 }
 
 void EuroinvestorMarketDataBackend::handleRequestError(QNetworkReply::NetworkError error) {
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    qWarning() << "EuroinvestorMarketDataBackend::handleRequestError:" << static_cast<int>(error)
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
+    qCWarning(lcNetwork) << "EuroinvestorMarketDataBackend::handleRequestError:" << static_cast<int>(error)
                << reply->errorString() << reply->readAll();
 
     emit requestError("Return code: " + QString::number(static_cast<int>(error)) + " - " + reply->errorString());
 }
 
-QDateTime EuroinvestorMarketDataBackend::convertUTCDateTimeToLocalDateTime(const QString &utcDateTimeString) {
-    QDateTime utcDateTime = QDateTime::fromString(utcDateTimeString, Qt::ISODate);
-    QDateTime localDateTime = QDateTime(utcDateTime.date(), utcDateTime.time(), Qt::UTC).toLocalTime();
-
-    qDebug() << " converted date from " << utcDateTimeString << " to " << localDateTime;
-
-    return localDateTime;
-}
-
 QString EuroinvestorMarketDataBackend::convertToDatabaseDateTimeFormat(const QDateTime &time) {
     return time.toString("yyyy-MM-dd") + " " + time.toString("hh:mm:ss");
 }
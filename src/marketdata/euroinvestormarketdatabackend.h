@@ -1,16 +1,17 @@
 #ifndef EUROINVESTORMARKETDATABACKEND_H
 #define EUROINVESTORMARKETDATABACKEND_H
 
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
 
+#include "../network/networkservice.h"
+
 const char API_MARKET_DATA[] = "https://api.euroinvestor.dk/instruments?ids=";
 
 class EuroinvestorMarketDataBackend : public QObject {
     Q_OBJECT
 public:
-    explicit EuroinvestorMarketDataBackend(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    explicit EuroinvestorMarketDataBackend(NetworkService *networkService, QObject *parent = nullptr);
     ~EuroinvestorMarketDataBackend();
 
     Q_INVOKABLE void lookupMarketData(const QString &marketDataIds);
@@ -21,18 +22,15 @@ public:
     Q_SIGNAL void requestError(const QString &errorMessage);
 
 protected:
-    QNetworkAccessManager *manager;
-
-    QNetworkReply *executeGetRequest(const QUrl &url);
+    NetworkService *networkService;
 
 private:
     QMap<QString, QString> marketDataId2ExtRefId;
 
     QString processMarketDataResult(QByteArray marketDataResult);
 
-    // TODO next two methods are also in the euroinvestor backend hierarchy - needs to be consolidated
+    // TODO method is also in the euroinvestor backend hierarchy - needs to be consolidated
     QString convertToDatabaseDateTimeFormat(const QDateTime &time);
-    QDateTime convertUTCDateTimeToLocalDateTime(const QString &utcDateTimeString);
 
 protected slots:
 
@@ -0,0 +1,373 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "networkservice.h"
+#include "../loggingcategories.h"
+
+#include <QDebug>
+#include <QStandardPaths>
+#include <QTimer>
+
+NetworkService::NetworkService(QNetworkAccessManager *manager, QObject *parent)
+    : QObject(parent)
+    , requestScheduler(new RequestScheduler(manager, this))
+    , responseProcessor(new ResponseProcessor(this))
+    , tlsSessionStore(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/tls_sessions.ini") {
+    qCDebug(lcNetwork) << "Initializing Network Service...";
+    clock.start();
+    tlsSessionSaveTimer.setSingleShot(true);
+    tlsSessionSaveTimer.setInterval(TLS_SESSION_SAVE_DELAY_MSECS);
+    connect(&tlsSessionSaveTimer, &QTimer::timeout, this, [this]() { tlsSessionStore.save(); });
+    connect(requestScheduler, SIGNAL(requestStarted(QNetworkReply *)), this, SLOT(handleRequestStarted(QNetworkReply *)));
+}
+
+NetworkService::~NetworkService() {
+    qCInfo(lcNetwork) << "Shutting down Network Service... saved requests :" << savedRequests;
+    QHashIterator<QString, TimeToFirstByte> iterator(timeToFirstByte);
+    while (iterator.hasNext()) {
+        iterator.next();
+        const TimeToFirstByte &ttfb = iterator.value();
+        qCInfo(lcNetwork) << "time to first byte for" << iterator.key() << "- first request without preconnect :"
+                 << (ttfb.coldRequests > 0 ? ttfb.coldMSecs / ttfb.coldRequests : -1)
+                 << "ms, preconnected :"
+                 << (ttfb.preconnectedRequests > 0 ? ttfb.preconnectedMSecs / ttfb.preconnectedRequests : -1)
+                 << "ms, average :" << (ttfb.totalRequests > 0 ? ttfb.totalMSecs / ttfb.totalRequests : -1) << "ms";
+    }
+}
+
+PendingReply *NetworkService::get(const QNetworkRequest &request, RequestScheduler::RequestPriority priority) {
+    const QUrl url = request.url();
+    PendingReply *pendingReply = createPendingReply(url);
+
+    if (inFlightRequests.contains(url)) {
+        InFlightRequest &inFlightRequest = inFlightRequests[url];
+        inFlightRequest.pendingReplies.append(pendingReply);
+        // the request was already sent - queued requests start the deadline when the scheduler sends them
+        if (inFlightRequest.reply != nullptr || inFlightRequest.attempt > 0) {
+            pendingReply->startDeadline();
+        }
+        // the user is now waiting for a queued background request
+        if (inFlightRequest.reply == nullptr && inFlightRequest.priority == RequestScheduler::BACKGROUND
+            && priority == RequestScheduler::INTERACTIVE) {
+            inFlightRequest.priority = RequestScheduler::INTERACTIVE;
+            requestScheduler->promote(url);
+        }
+        savedRequests++;
+        qCDebug(lcNetwork) << "NetworkService::get - attached to pending request for" << url << "- saved requests :"
+                 << savedRequests;
+        emit savedRequestsChanged(savedRequests);
+        return pendingReply;
+    }
+
+    if (!circuitBreaker.allowRequest(url.host(), clock.elapsed())) {
+        qCDebug(lcNetwork) << "NetworkService::get - host " << url.host() << " is unavailable, not sending request for" << url;
+        failFast(QList<QPointer<PendingReply>>() << pendingReply);
+        return pendingReply;
+    }
+
+    InFlightRequest inFlightRequest;
+    inFlightRequest.priority = priority;
+    inFlightRequest.request = request;
+    if (url.scheme() == "https") {
+        inFlightRequest.request.setSslConfiguration(sslConfigurationForHost(url.host()));
+    }
+    inFlightRequest.pendingReplies.append(pendingReply);
+    // register before enqueueing - the scheduler may start the request immediately
+    inFlightRequests.insert(url, inFlightRequest);
+
+    requestScheduler->enqueue(inFlightRequest.request, priority);
+
+    return pendingReply;
+}
+
+PendingReply *NetworkService::getBatched(const QString &urlPrefix,
+                                        const QStringList &ids,
+                                        RequestScheduler::RequestPriority priority) {
+    if (!quoteBatchers.contains(urlPrefix)) {
+        quoteBatchers.insert(urlPrefix, new QuoteBatcher(this, urlPrefix, this));
+    }
+    // the batch requests go through get() - their deadline fails the lookups if the api does not answer
+    PendingReply *pendingReply = createPendingReply(QUrl(urlPrefix + ids.join(",")));
+    quoteBatchers.value(urlPrefix)->lookup(pendingReply, ids, priority);
+    return pendingReply;
+}
+
+PendingReply *NetworkService::createPendingReply(const QUrl &url) {
+    PendingReply *pendingReply = new PendingReply(url);
+    pendingReply->requestTag = requestScopeTag;
+    pendingReply->setDeadline(DEFAULT_REQUEST_DEADLINE_MSECS);
+    connect(pendingReply, SIGNAL(abortRequested()), this, SLOT(handleAbortRequested()));
+    connect(pendingReply, SIGNAL(deadlineExceeded()), this, SLOT(handleDeadlineExceeded()));
+    return pendingReply;
+}
+
+void NetworkService::processInBackground(const QByteArray &data,
+                                         const ParseFunction &parseFunction,
+                                         QObject *receiver,
+                                         const ResultHandler &resultHandler,
+                                         const QString &tag,
+                                         const CancelHandler &cancelHandler) {
+    responseProcessor->process(data, parseFunction, receiver, resultHandler, tag, cancelHandler);
+}
+
+int NetworkService::getSavedRequests() const {
+    return savedRequests;
+}
+
+QSslConfiguration NetworkService::sslConfigurationForHost(const QString &host) const {
+    return tlsSessionStore.sslConfiguration(host,
+                                            QSslConfiguration::defaultConfiguration(),
+                                            QDateTime::currentDateTimeUtc());
+}
+
+void NetworkService::beginRequestScope(const QString &tag) {
+    requestScopeTag = tag;
+}
+
+void NetworkService::endRequestScope() {
+    requestScopeTag.clear();
+}
+
+void NetworkService::abortRequests(const QString &tag) {
+    QList<QPointer<PendingReply>> pendingRepliesToAbort;
+    foreach (const InFlightRequest &inFlightRequest, inFlightRequests) {
+        foreach (const QPointer<PendingReply> &pendingReply, inFlightRequest.pendingReplies) {
+            if (!pendingReply.isNull() && pendingReply->tag() == tag) {
+                pendingRepliesToAbort.append(pendingReply);
+            }
+        }
+    }
+
+    qCDebug(lcNetwork) << "NetworkService::abortRequests - aborting " << pendingRepliesToAbort.size() << " requests for " << tag;
+    responseProcessor->cancel(tag);
+    foreach (QuoteBatcher *quoteBatcher, quoteBatchers) {
+        quoteBatcher->abortLookups(tag);
+    }
+
+    // aborting modifies the in flight requests - abort after collecting
+    foreach (const QPointer<PendingReply> &pendingReply, pendingRepliesToAbort) {
+        if (!pendingReply.isNull()) {
+            pendingReply->abort();
+        }
+    }
+}
+
+void NetworkService::registerPreconnectedHost(const QString &host) {
+    preconnectedHosts.insert(host);
+}
+
+void NetworkService::handleRequestStarted(QNetworkReply *reply) {
+    const QUrl url = reply->request().url();
+    if (inFlightRequests.contains(url)) {
+        InFlightRequest &inFlightRequest = inFlightRequests[url];
+        inFlightRequest.reply = reply;
+        inFlightRequest.startedMSecs = clock.elapsed();
+        // a large refresh waits in the queue because of the rate limits - only the time on the wire counts
+        foreach (const QPointer<PendingReply> &pendingReply, inFlightRequest.pendingReplies) {
+            if (!pendingReply.isNull()) {
+                pendingReply->startDeadline();
+            }
+        }
+    }
+    connect(reply, SIGNAL(metaDataChanged()), this, SLOT(handleMetaDataChanged()));
+    connect(reply, SIGNAL(finished()), this, SLOT(handleRequestFinished()));
+}
+
+void NetworkService::handleMetaDataChanged() {
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    // only the first response headers are of interest
+    disconnect(reply, SIGNAL(metaDataChanged()), this, SLOT(handleMetaDataChanged()));
+
+    const QUrl url = reply->request().url();
+    if (inFlightRequests.value(url).reply != reply
+        || reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+        return;
+    }
+
+    const QString host = url.host();
+    const qint64 msecs = clock.elapsed() - inFlightRequests.value(url).startedMSecs;
+    const bool firstRequest = !timeToFirstByte.contains(host);
+    const bool preconnected = preconnectedHosts.remove(host);
+
+    TimeToFirstByte &ttfb = timeToFirstByte[host];
+    if (preconnected) {
+        ttfb.preconnectedMSecs += msecs;
+        ttfb.preconnectedRequests++;
+    } else if (firstRequest) {
+        ttfb.coldMSecs += msecs;
+        ttfb.coldRequests++;
+    }
+    ttfb.totalMSecs += msecs;
+    ttfb.totalRequests++;
+
+    qCDebug(lcNetwork) << "NetworkService::handleMetaDataChanged - time to first byte for" << url << ":" << msecs
+             << "ms" << (preconnected ? "(preconnected)" : "");
+}
+
+void NetworkService::handleRequestFinished() {
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    reply->deleteLater();
+
+    const QUrl url = reply->request().url();
+    if (inFlightRequests.value(url).reply != reply) {
+        // cancelled - a new request for the url may already be pending
+        return;
+    }
+    updateTlsSession(reply);
+    const int httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (RetryPolicy::isRetryable(reply->error(), httpStatusCode)) {
+        if (scheduleRetry(url, reply)) {
+            return;
+        }
+        // one failure per request - a flaky request with a few retries does not open the circuit of the host
+        circuitBreaker.recordFailure(url.host(), clock.elapsed());
+    } else {
+        circuitBreaker.recordSuccess(url.host());
+    }
+
+    // remove the request first - new requests for the same url issued by the receivers must not be attached
+    const QList<QPointer<PendingReply>> pendingReplies = inFlightRequests.take(url).pendingReplies;
+
+    ReplyResult result;
+    result.error = reply->error();
+    result.errorString = reply->errorString();
+    result.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+    result.fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+    result.data = reply->readAll();
+
+    completePendingReplies(pendingReplies, result);
+}
+
+void NetworkService::updateTlsSession(const QNetworkReply *reply) {
+    const QUrl url = reply->request().url();
+    if (url.scheme() != "https" || reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+        return;
+    }
+
+    const QSslConfiguration sslConfiguration = reply->sslConfiguration();
+    tlsSessionStore.update(url.host(),
+                           sslConfiguration.sessionTicket(),
+                           sslConfiguration.sessionTicketLifeTimeHint(),
+                           QDateTime::currentDateTimeUtc());
+    // the file is rewritten once for all tickets that arrive in the meantime - the rest is saved on shutdown
+    if (tlsSessionStore.hasChanges() && !tlsSessionSaveTimer.isActive()) {
+        tlsSessionSaveTimer.start();
+    }
+}
+
+bool NetworkService::scheduleRetry(const QUrl &url, const QNetworkReply *reply) {
+    if (!inFlightRequests.contains(url)) {
+        return false;
+    }
+    InFlightRequest &inFlightRequest = inFlightRequests[url];
+    if (inFlightRequest.attempt >= MAXIMUM_RETRIES) {
+        return false;
+    }
+
+    qint64 delay = RetryPolicy::retryAfterDelay(reply->rawHeader("Retry-After"), QDateTime::currentDateTimeUtc());
+    if (delay > RETRY_MAXIMUM_DELAY_MSECS) {
+        // the server told us to stay away - do not send any request to it until then
+        circuitBreaker.openUntil(url.host(), clock.elapsed() + delay);
+        return false;
+    }
+    if (delay < 0) {
+        delay = RetryPolicy::backoffDelay(inFlightRequest.attempt);
+    }
+    if (circuitBreaker.isOpen(url.host(), clock.elapsed() + delay)) {
+        return false;
+    }
+
+    inFlightRequest.attempt++;
+    inFlightRequest.reply = nullptr;
+    qCDebug(lcNetwork) << "NetworkService::scheduleRetry - " << url << " failed with " << reply->error() << ", attempt "
+             << inFlightRequest.attempt << " in " << delay << "ms";
+
+    QTimer::singleShot(static_cast<int>(delay), this, [this, url]() { retryRequest(url); });
+    return true;
+}
+
+void NetworkService::retryRequest(const QUrl &url) {
+    if (!inFlightRequests.contains(url)) {
+        return;
+    }
+    if (circuitBreaker.isOpen(url.host(), clock.elapsed())) {
+        failFast(inFlightRequests.take(url).pendingReplies);
+        return;
+    }
+    const InFlightRequest &inFlightRequest = inFlightRequests[url];
+    requestScheduler->enqueue(inFlightRequest.request, inFlightRequest.priority);
+}
+
+void NetworkService::failFast(const QList<QPointer<PendingReply>> &pendingReplies) {
+    ReplyResult result;
+    result.error = QNetworkReply::ServiceUnavailableError;
+    result.errorString = tr("Service temporarily unavailable");
+
+    // the caller connects its slots after get() returned - complete on the next event loop iteration
+    QTimer::singleShot(0, this, [this, pendingReplies, result]() { completePendingReplies(pendingReplies, result); });
+}
+
+void NetworkService::completePendingReplies(const QList<QPointer<PendingReply>> &pendingReplies,
+                                            const ReplyResult &result) {
+    foreach (const QPointer<PendingReply> &pendingReply, pendingReplies) {
+        if (!pendingReply.isNull()) {
+            pendingReply->complete(result);
+        }
+    }
+}
+
+void NetworkService::detachPendingReply(PendingReply *pendingReply) {
+    const QUrl url = pendingReply->url();
+    if (!inFlightRequests.contains(url)) {
+        return;
+    }
+
+    InFlightRequest &inFlightRequest = inFlightRequests[url];
+    inFlightRequest.pendingReplies.removeAll(pendingReply);
+    foreach (const QPointer<PendingReply> &remainingReply, inFlightRequest.pendingReplies) {
+        if (!remainingReply.isNull()) {
+            return;
+        }
+    }
+
+    // nobody is waiting for the response anymore
+    const InFlightRequest cancelledRequest = inFlightRequests.take(url);
+    if (cancelledRequest.reply == nullptr) {
+        requestScheduler->cancel(url);
+    } else {
+        cancelledRequest.reply->abort();
+    }
+    circuitBreaker.releaseProbe(url.host());
+    qCDebug(lcNetwork) << "NetworkService::detachPendingReply - cancelled request for" << url;
+}
+
+void NetworkService::handleAbortRequested() {
+    PendingReply *pendingReply = qobject_cast<PendingReply *>(sender());
+    detachPendingReply(pendingReply);
+    pendingReply->deleteLater();
+}
+
+void NetworkService::handleDeadlineExceeded() {
+    PendingReply *pendingReply = qobject_cast<PendingReply *>(sender());
+    qCDebug(lcNetwork) << "NetworkService::handleDeadlineExceeded - " << pendingReply->url();
+    detachPendingReply(pendingReply);
+
+    ReplyResult result;
+    result.error = QNetworkReply::TimeoutError;
+    result.errorString = tr("Request timed out");
+    pendingReply->complete(result);
+}
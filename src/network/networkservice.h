@@ -0,0 +1,148 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NETWORK_SERVICE_H
+#define NETWORK_SERVICE_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <QUrl>
+
+#include "pendingreply.h"
+#include "quotebatcher.h"
+#include "requestscheduler.h"
+#include "responseprocessor.h"
+#include "retrypolicy.h"
+#include "tlssessionstore.h"
+
+// time after sending until a request fails with a timeout if the caller does not set its own deadline
+const int DEFAULT_REQUEST_DEADLINE_MSECS = 60 * 1000;
+
+/**
+ * Executes the requests of all backends. Requests for an url that is already being fetched are not
+ * sent again - the caller is attached to the pending request and gets the same response.
+ * The requests are started by the RequestScheduler which limits the number of concurrent requests.
+ * Failed requests are retried with backoff, requests to a host that keeps failing fail fast.
+ * Requests can be tagged with a scope (e.g. a page) and aborted together when they are not needed anymore.
+ */
+class NetworkService : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int savedRequests READ getSavedRequests NOTIFY savedRequestsChanged)
+public:
+    explicit NetworkService(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    ~NetworkService() override;
+
+    PendingReply *get(const QNetworkRequest &request,
+                      RequestScheduler::RequestPriority priority = RequestScheduler::INTERACTIVE);
+    // quote lookup for apis with a comma separated id list - lookups of different callers are merged (see QuoteBatcher)
+    PendingReply *getBatched(const QString &urlPrefix,
+                             const QStringList &ids,
+                             RequestScheduler::RequestPriority priority = RequestScheduler::INTERACTIVE);
+
+    // number of requests that were not sent because an identical request was already pending
+    int getSavedRequests() const;
+
+    // parses the response data on the processing thread - the result handler is called on the thread of the receiver
+    // unless the requests of the tag (see PendingReply::tag) were aborted in the meantime, then the cancel handler is
+    void processInBackground(const QByteArray &data,
+                             const ParseFunction &parseFunction,
+                             QObject *receiver,
+                             const ResultHandler &resultHandler,
+                             const QString &tag = QString(),
+                             const CancelHandler &cancelHandler = CancelHandler());
+
+    // requests created until endRequestScope() is called get the tag
+    Q_INVOKABLE void beginRequestScope(const QString &tag);
+    Q_INVOKABLE void endRequestScope();
+    // aborts all pending requests with the tag - their results are not processed, not even the ones that are
+    // already waiting for the processing thread
+    Q_INVOKABLE void abortRequests(const QString &tag);
+
+    // the connection to the host was opened in advance - the time to first byte of the next request shows the gain
+    void registerPreconnectedHost(const QString &host);
+    // ssl configuration with the stored tls session of the host
+    QSslConfiguration sslConfigurationForHost(const QString &host) const;
+
+signals:
+    void savedRequestsChanged(int savedRequests);
+
+private:
+    struct InFlightRequest
+    {
+        // null until the request was started by the scheduler
+        QNetworkReply *reply = nullptr;
+        RequestScheduler::RequestPriority priority = RequestScheduler::INTERACTIVE;
+        QNetworkRequest request;
+        int attempt = 0;
+        // time of the clock when the scheduler started the request - base of the time to first byte
+        qint64 startedMSecs = 0;
+        QList<QPointer<PendingReply>> pendingReplies;
+    };
+
+    // time to first byte of the requests to a host
+    struct TimeToFirstByte
+    {
+        // first request to the host without a preconnected connection
+        qint64 coldMSecs = 0;
+        int coldRequests = 0;
+        // first request on a preconnected connection
+        qint64 preconnectedMSecs = 0;
+        int preconnectedRequests = 0;
+        qint64 totalMSecs = 0;
+        int totalRequests = 0;
+    };
+
+    RequestScheduler *const requestScheduler;
+    ResponseProcessor *const responseProcessor;
+    QHash<QUrl, InFlightRequest> inFlightRequests;
+    int savedRequests = 0;
+    TlsSessionStore tlsSessionStore;
+    QTimer tlsSessionSaveTimer;
+    CircuitBreaker circuitBreaker;
+    QElapsedTimer clock;
+    QString requestScopeTag;
+    QHash<QString, QuoteBatcher *> quoteBatchers;
+    QHash<QString, TimeToFirstByte> timeToFirstByte;
+    // hosts with an opened connection that was not used by a request yet
+    QSet<QString> preconnectedHosts;
+
+    bool scheduleRetry(const QUrl &url, const QNetworkReply *reply);
+    void retryRequest(const QUrl &url);
+    void updateTlsSession(const QNetworkReply *reply);
+    void failFast(const QList<QPointer<PendingReply>> &pendingReplies);
+    void completePendingReplies(const QList<QPointer<PendingReply>> &pendingReplies, const ReplyResult &result);
+    // removes the reply from its request - the request is cancelled when nobody is waiting for it anymore
+    void detachPendingReply(PendingReply *pendingReply);
+    // reply with the current request tag and the default deadline that can be aborted like the replies of get()
+    PendingReply *createPendingReply(const QUrl &url);
+
+private slots:
+    void handleRequestStarted(QNetworkReply *reply);
+    void handleRequestFinished();
+    void handleMetaDataChanged();
+    void handleAbortRequested();
+    void handleDeadlineExceeded();
+};
+
+#endif // NETWORK_SERVICE_H
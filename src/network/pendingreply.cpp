@@ -0,0 +1,102 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "pendingreply.h"
+
+PendingReply::PendingReply(const QUrl &url, QObject *parent)
+    : QObject(parent)
+    , requestUrl(url) {
+    deadlineTimer.setSingleShot(true);
+    connect(&deadlineTimer, SIGNAL(timeout()), this, SIGNAL(deadlineExceeded()));
+}
+
+QUrl PendingReply::url() const {
+    return requestUrl;
+}
+
+bool PendingReply::isFinished() const {
+    return replyFinished;
+}
+
+QNetworkReply::NetworkError PendingReply::error() const {
+    return result.error;
+}
+
+QString PendingReply::errorString() const {
+    return result.errorString;
+}
+
+QVariant PendingReply::attribute(QNetworkRequest::Attribute code) const {
+    switch (code) {
+    case QNetworkRequest::HttpStatusCodeAttribute:
+        return result.httpStatusCode;
+    case QNetworkRequest::SourceIsFromCacheAttribute:
+        return QVariant(result.fromCache);
+    default:
+        return QVariant();
+    }
+}
+
+QByteArray PendingReply::readAll() const {
+    return result.data;
+}
+
+QString PendingReply::tag() const {
+    return requestTag;
+}
+
+void PendingReply::abort() {
+    if (replyFinished || replyAborted) {
+        return;
+    }
+    replyAborted = true;
+    deadlineTimer.stop();
+    emit abortRequested();
+
+    replyFinished = true;
+    result.error = QNetworkReply::OperationCanceledError;
+    result.errorString = tr("Operation canceled");
+    emit finished();
+}
+
+void PendingReply::setDeadline(int msecs) {
+    deadlineMSecs = msecs;
+    if (deadlineTimer.isActive()) {
+        deadlineTimer.start(msecs);
+    }
+}
+
+void PendingReply::startDeadline() {
+    if (deadlineMSecs >= 0 && !deadlineTimer.isActive() && !replyFinished && !replyAborted) {
+        deadlineTimer.start(deadlineMSecs);
+    }
+}
+
+void PendingReply::complete(const ReplyResult &replyResult) {
+    if (replyFinished || replyAborted) {
+        return;
+    }
+    replyFinished = true;
+    deadlineTimer.stop();
+    result = replyResult;
+
+    // same order as QNetworkReply - error first, then finished
+    if (result.error != QNetworkReply::NoError) {
+        emit error(result.error);
+    }
+    emit finished();
+}
@@ -0,0 +1,93 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef PENDING_REPLY_H
+#define PENDING_REPLY_H
+
+#include <QByteArray>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QTimer>
+#include <QUrl>
+#include <QVariant>
+
+// result of a network request - shared by all replies waiting for the same request
+struct ReplyResult
+{
+    QNetworkReply::NetworkError error = QNetworkReply::NoError;
+    QString errorString;
+    QVariant httpStatusCode;
+    bool fromCache = false;
+    QByteArray data;
+};
+
+/**
+ * Reply of a request executed by the NetworkService. Each caller gets its own instance, even if the
+ * underlying network request is shared with other callers. The interface mirrors the parts of
+ * QNetworkReply that the backends use, so the backends can handle it the same way.
+ * An aborted reply finishes right away with an OperationCanceledError, like an aborted QNetworkReply, so the
+ * caller can release the state of its request. It does not emit error() - there is nothing to report to the
+ * user - and the response of the request is not processed at all.
+ */
+class PendingReply : public QObject {
+    Q_OBJECT
+public:
+    explicit PendingReply(const QUrl &url, QObject *parent = nullptr);
+    ~PendingReply() override = default;
+
+    QUrl url() const;
+    bool isFinished() const;
+    QNetworkReply::NetworkError error() const;
+    QString errorString() const;
+    QVariant attribute(QNetworkRequest::Attribute code) const;
+    QByteArray readAll() const;
+    // tag of the request scope the reply was created in - see NetworkService::beginRequestScope
+    QString tag() const;
+
+    void abort();
+    // the reply fails with a TimeoutError if it has not finished the given time after the request was sent -
+    // the time in the queue of the scheduler does not count
+    void setDeadline(int msecs);
+
+signals:
+    void error(QNetworkReply::NetworkError);
+    void finished();
+    void abortRequested();
+    void deadlineExceeded();
+
+private:
+    QUrl requestUrl;
+    QString requestTag;
+    bool replyFinished = false;
+    bool replyAborted = false;
+    ReplyResult result;
+    QTimer deadlineTimer;
+    int deadlineMSecs = -1;
+
+    // called when the request is sent - the deadline timer of a retried request keeps running
+    void startDeadline();
+    void complete(const ReplyResult &replyResult);
+
+    friend class NetworkService;
+    friend class QuoteBatcher;
+#ifdef UNIT_TEST
+    friend class NetworkTests;
+#endif
+};
+
+#endif // PENDING_REPLY_H
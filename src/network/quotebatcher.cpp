@@ -0,0 +1,288 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "quotebatcher.h"
+#include "../loggingcategories.h"
+#include "networkservice.h"
+#include "../constants.h"
+#include "../securitydata/jsonstreamreader.h"
+
+#include <QDebug>
+#include <QSet>
+#include <QVariantHash>
+
+QuoteBatcher::QuoteBatcher(NetworkService *networkService, const QString &urlPrefix, QObject *parent)
+    : QObject(parent)
+    , networkService(networkService)
+    , urlPrefix(urlPrefix) {
+    batchTimer.setSingleShot(true);
+    batchTimer.setInterval(QUOTE_BATCH_WINDOW_MSECS);
+    connect(&batchTimer, SIGNAL(timeout()), this, SLOT(flush()));
+}
+
+void QuoteBatcher::lookup(PendingReply *pendingReply,
+                          const QStringList &ids,
+                          RequestScheduler::RequestPriority priority) {
+    QuoteLookup quoteLookup;
+    quoteLookup.pendingReply = pendingReply;
+    quoteLookup.ids = ids;
+    quoteLookup.priority = priority;
+    queuedLookups.append(quoteLookup);
+    // the lookup is not queued by the scheduler - the batch window and the batch requests count for its deadline
+    pendingReply->startDeadline();
+
+    // the window starts with the first lookup - later lookups do not delay the batch any further
+    if (!batchTimer.isActive()) {
+        batchTimer.start();
+    }
+}
+
+void QuoteBatcher::abortLookups(const QString &tag) {
+    QList<QPointer<PendingReply>> pendingRepliesToAbort;
+    foreach (const QuoteLookup &quoteLookup, queuedLookups) {
+        if (!quoteLookup.pendingReply.isNull() && quoteLookup.pendingReply->tag() == tag) {
+            pendingRepliesToAbort.append(quoteLookup.pendingReply);
+        }
+    }
+    foreach (const Batch *batch, openBatches) {
+        foreach (const QuoteLookup &quoteLookup, batch->lookups) {
+            if (!quoteLookup.pendingReply.isNull() && quoteLookup.pendingReply->tag() == tag) {
+                pendingRepliesToAbort.append(quoteLookup.pendingReply);
+            }
+        }
+    }
+
+    // an aborted reply is deleted - the batch skips it when it is complete
+    foreach (const QPointer<PendingReply> &pendingReply, pendingRepliesToAbort) {
+        if (!pendingReply.isNull()) {
+            pendingReply->abort();
+        }
+    }
+
+    // nobody waits for a batch whose lookups are all gone - its requests are aborted as well
+    QList<QPointer<PendingReply>> batchRepliesToAbort;
+    for (auto it = batchRequests.constBegin(); it != batchRequests.constEnd(); ++it) {
+        if (!hasWaitingLookups(it.value())) {
+            batchRepliesToAbort.append(it.key());
+        }
+    }
+    foreach (const QPointer<PendingReply> &batchReply, batchRepliesToAbort) {
+        if (!batchReply.isNull()) {
+            batchReply->abort();
+        }
+    }
+}
+
+bool QuoteBatcher::hasWaitingLookups(const Batch *batch) const {
+    foreach (const QuoteLookup &quoteLookup, batch->lookups) {
+        if (!quoteLookup.pendingReply.isNull() && !quoteLookup.pendingReply->isFinished()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void QuoteBatcher::setBatchWindow(int msecs) {
+    batchTimer.setInterval(msecs);
+}
+
+QList<QStringList> QuoteBatcher::splitIds(const QStringList &ids, int urlPrefixLength, int maximumUrlLength) {
+    QList<QStringList> idLists;
+    QStringList currentIds;
+    int currentLength = urlPrefixLength;
+
+    foreach (const QString &id, ids) {
+        const int additionalLength = (currentIds.isEmpty() ? 0 : 1) + id.length();
+        if (!currentIds.isEmpty() && currentLength + additionalLength > maximumUrlLength) {
+            idLists.append(currentIds);
+            currentIds.clear();
+            currentLength = urlPrefixLength;
+        }
+        currentLength += (currentIds.isEmpty() ? 0 : 1) + id.length();
+        currentIds.append(id);
+    }
+    if (!currentIds.isEmpty()) {
+        idLists.append(currentIds);
+    }
+    return idLists;
+}
+
+QHash<QString, QByteArray> QuoteBatcher::splitQuotes(const QByteArray &response) {
+    QHash<QString, QByteArray> quotes;
+    JsonStreamReader reader;
+    reader.addData(response);
+    reader.finish();
+
+    if (reader.readNext() != JsonStreamReader::START_ARRAY) {
+        return quotes;
+    }
+
+    int objectStart = -1;
+    QString id;
+    for (JsonStreamReader::TokenType token = reader.readNext(); token != JsonStreamReader::END_OF_DATA;
+         token = reader.readNext()) {
+        if (token == JsonStreamReader::INVALID) {
+            qCWarning(lcParse) << "QuoteBatcher::splitQuotes - invalid json";
+            return QHash<QString, QByteArray>();
+        }
+        if (token == JsonStreamReader::START_OBJECT && reader.depth() == 2) {
+            objectStart = reader.offset() - 1;
+            id.clear();
+        } else if (reader.depth() == 2 && reader.key(1) == QLatin1String("id")) {
+            if (token == JsonStreamReader::STRING) {
+                id = reader.stringValue();
+            } else if (token == JsonStreamReader::NUMBER) {
+                id = QString::number(static_cast<qint64>(reader.numberValue()));
+            }
+        } else if (token == JsonStreamReader::END_OBJECT && reader.depth() == 1) {
+            if (objectStart >= 0 && !id.isEmpty()) {
+                quotes.insert(id, response.mid(objectStart, reader.offset() - objectStart));
+            }
+            objectStart = -1;
+        }
+    }
+    return quotes;
+}
+
+void QuoteBatcher::flush() {
+    // aborted and timed out lookups are not requested anymore
+    QList<QuoteLookup> lookups;
+    foreach (const QuoteLookup &quoteLookup, queuedLookups) {
+        if (!quoteLookup.pendingReply.isNull() && !quoteLookup.pendingReply->isFinished()) {
+            lookups.append(quoteLookup);
+        }
+    }
+    queuedLookups.clear();
+    if (lookups.isEmpty()) {
+        return;
+    }
+
+    Batch *batch = new Batch();
+    batch->lookups = lookups;
+    openBatches.append(batch);
+
+    // distinct ids of all lookups - the batch is interactive if any caller is
+    QStringList ids;
+    QSet<QString> knownIds;
+    RequestScheduler::RequestPriority priority = RequestScheduler::BACKGROUND;
+    foreach (const QuoteLookup &quoteLookup, batch->lookups) {
+        foreach (const QString &id, quoteLookup.ids) {
+            if (!knownIds.contains(id)) {
+                knownIds.insert(id);
+                ids.append(id);
+            }
+        }
+        if (quoteLookup.priority == RequestScheduler::INTERACTIVE) {
+            priority = RequestScheduler::INTERACTIVE;
+        }
+    }
+
+    const QList<QStringList> idLists = splitIds(ids, urlPrefix.length(), QUOTE_BATCH_MAXIMUM_URL_LENGTH);
+    qCDebug(lcNetwork) << "QuoteBatcher::flush - " << batch->lookups.size() << " lookups, " << ids.size() << " ids, "
+             << idLists.size() << " requests";
+
+    batch->openRequests = idLists.size();
+    foreach (const QStringList &idList, idLists) {
+        QNetworkRequest request(QUrl(urlPrefix + idList.join(",")));
+        request.setHeader(QNetworkRequest::ContentTypeHeader, MIME_TYPE_JSON);
+        request.setHeader(QNetworkRequest::UserAgentHeader, USER_AGENT);
+
+        PendingReply *reply = networkService->get(request, priority);
+        batchRequests.insert(reply, batch);
+        connect(reply, SIGNAL(finished()), this, SLOT(handleBatchRequestFinished()));
+    }
+}
+
+void QuoteBatcher::handleBatchRequestFinished() {
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
+    reply->deleteLater();
+
+    Batch *batch = batchRequests.take(reply);
+    if (batch == nullptr) {
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        // a timed out batch request fails its lookups with the TimeoutError of the request deadline
+        batch->failedResult.error = reply->error();
+        batch->failedResult.errorString = reply->errorString();
+        batch->failedResult.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+        completeRequest(batch);
+        return;
+    }
+
+    // the merged response of all callers is split on the processing thread
+    networkService->processInBackground(
+        reply->readAll(),
+        [](const QByteArray &data) {
+            QVariantHash quotes;
+            const QHash<QString, QByteArray> quoteSlices = splitQuotes(data);
+            for (auto it = quoteSlices.constBegin(); it != quoteSlices.constEnd(); ++it) {
+                quotes.insert(it.key(), it.value());
+            }
+            return QVariant(quotes);
+        },
+        this,
+        [this, batch](const QVariant &quotes) {
+            const QVariantHash quoteSlices = quotes.toHash();
+            for (auto it = quoteSlices.constBegin(); it != quoteSlices.constEnd(); ++it) {
+                batch->quotes.insert(it.key(), it.value().toByteArray());
+            }
+            completeRequest(batch);
+        });
+}
+
+void QuoteBatcher::completeRequest(Batch *batch) {
+    batch->openRequests--;
+    if (batch->openRequests == 0) {
+        openBatches.removeOne(batch);
+        completeBatch(batch);
+        delete batch;
+    }
+}
+
+void QuoteBatcher::completeBatch(Batch *batch) {
+    foreach (const QuoteLookup &quoteLookup, batch->lookups) {
+        if (quoteLookup.pendingReply.isNull()) {
+            continue;
+        }
+
+        // the reply is the json array of the raw quote objects - nothing is serialised again
+        QByteArray quotes("[");
+        bool complete = true;
+        foreach (const QString &id, quoteLookup.ids) {
+            if (batch->quotes.contains(id)) {
+                if (quotes.size() > 1) {
+                    quotes.append(',');
+                }
+                quotes.append(batch->quotes.value(id));
+            } else {
+                complete = false;
+            }
+        }
+        quotes.append(']');
+
+        // instruments unknown to the api are not an error - missing instruments of a failed request are
+        if (!complete && batch->failedResult.error != QNetworkReply::NoError) {
+            quoteLookup.pendingReply->complete(batch->failedResult);
+        } else {
+            ReplyResult result;
+            result.data = quotes;
+            quoteLookup.pendingReply->complete(result);
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef QUOTE_BATCHER_H
+#define QUOTE_BATCHER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+
+#include "pendingreply.h"
+#include "requestscheduler.h"
+
+class NetworkService;
+
+// lookups within this time are merged into one request
+const int QUOTE_BATCH_WINDOW_MSECS = 50;
+// longer urls are rejected by some servers and proxies
+const int QUOTE_BATCH_MAXIMUM_URL_LENGTH = 2000;
+
+/**
+ * Merges the quote lookups of different callers for an api that accepts a comma separated id list
+ * (e.g. "instruments?ids=1,2,3") and answers with a json array of objects with an "id" attribute.
+ * Each caller gets a reply that only contains the instruments it asked for. The response is split into
+ * the raw json of each instrument on the processing thread - the replies are put together from these
+ * slices without parsing or serialising the quotes again.
+ */
+class QuoteBatcher : public QObject {
+    Q_OBJECT
+public:
+    explicit QuoteBatcher(NetworkService *networkService, const QString &urlPrefix, QObject *parent = nullptr);
+    ~QuoteBatcher() override = default;
+
+    // the reply is created by the NetworkService - it has the request tag and the deadline of other requests
+    void lookup(PendingReply *pendingReply, const QStringList &ids, RequestScheduler::RequestPriority priority);
+    // aborts the lookups of the request tag - see NetworkService::abortRequests
+    void abortLookups(const QString &tag);
+    void setBatchWindow(int msecs);
+
+    // splits the ids into id lists that fit into urls of the maximum length
+    static QList<QStringList> splitIds(const QStringList &ids, int urlPrefixLength, int maximumUrlLength);
+    // raw json of each object of the response array by its "id" attribute - called on the processing thread
+    static QHash<QString, QByteArray> splitQuotes(const QByteArray &response);
+
+private:
+    struct QuoteLookup
+    {
+        QPointer<PendingReply> pendingReply;
+        QStringList ids;
+        RequestScheduler::RequestPriority priority;
+    };
+
+    // all lookups of one batch window - the lookups are answered when all requests of the batch have finished
+    struct Batch
+    {
+        QList<QuoteLookup> lookups;
+        int openRequests = 0;
+        QHash<QString, QByteArray> quotes;
+        ReplyResult failedResult;
+    };
+
+    NetworkService *networkService;
+    const QString urlPrefix;
+    QList<QuoteLookup> queuedLookups;
+    QTimer batchTimer;
+    QHash<PendingReply *, Batch *> batchRequests;
+    // batches that wait for their requests or for the processing thread
+    QList<Batch *> openBatches;
+
+    // false if all lookups of the batch were aborted or have timed out
+    bool hasWaitingLookups(const Batch *batch) const;
+    void completeRequest(Batch *batch);
+    void completeBatch(Batch *batch);
+
+private slots:
+    void flush();
+    void handleBatchRequestFinished();
+
+#ifdef UNIT_TEST
+    friend class NetworkTests;
+#endif
+};
+
+#endif // QUOTE_BATCHER_H
@@ -0,0 +1,181 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "requestscheduler.h"
+#include "../loggingcategories.h"
+#include "../constants.h"
+
+#include <QDebug>
+#include <QSet>
+#include <QUrl>
+
+#include <math.h>
+
+TokenBucket::TokenBucket(double tokensPerSecond, int capacity)
+    : tokensPerSecond(tokensPerSecond)
+    , capacity(capacity)
+    , tokens(capacity) {
+}
+
+void TokenBucket::refill(qint64 nowMSecs) {
+    if (lastRefillMSecs >= 0 && nowMSecs > lastRefillMSecs) {
+        tokens = qMin(static_cast<double>(capacity),
+                      tokens + ((nowMSecs - lastRefillMSecs) * tokensPerSecond / 1000.0));
+    }
+    lastRefillMSecs = nowMSecs;
+}
+
+bool TokenBucket::tryConsume(qint64 nowMSecs, int reservedTokens) {
+    refill(nowMSecs);
+    if (tokens - reservedTokens >= 1.0) {
+        tokens -= 1.0;
+        return true;
+    }
+    return false;
+}
+
+qint64 TokenBucket::msecsUntilAvailable(qint64 nowMSecs, int reservedTokens) {
+    refill(nowMSecs);
+    const double missingTokens = (reservedTokens + 1.0) - tokens;
+    if (missingTokens <= 0.0) {
+        return 0;
+    }
+    return static_cast<qint64>(ceil(missingTokens * 1000.0 / tokensPerSecond));
+}
+
+RequestScheduler::RequestScheduler(QNetworkAccessManager *manager, QObject *parent)
+    : QObject(parent)
+    , manager(manager) {
+    qCDebug(lcNetwork) << "Initializing Request Scheduler...";
+    clock.start();
+
+    dispatchTimer.setSingleShot(true);
+    connect(&dispatchTimer, SIGNAL(timeout()), this, SLOT(dispatch()));
+
+    // ing diba has no batch quote api - so a watchlist refresh results in one request per security
+    setHostRateLimit(QUrl(ING_DIBA_API_QUOTE).host(), 5.0, 5);
+    setHostRateLimit(QUrl(MOSCOW_EXCHANGE_QUOTE).host(), 5.0, 5);
+}
+
+RequestScheduler::~RequestScheduler() {
+    qCDebug(lcNetwork) << "Shutting down Request Scheduler...";
+}
+
+void RequestScheduler::setHostRateLimit(const QString &host, double requestsPerSecond, int burst) {
+    tokenBuckets.insert(host, TokenBucket(requestsPerSecond, burst));
+}
+
+void RequestScheduler::enqueue(const QNetworkRequest &request, RequestPriority priority) {
+    if (priority == BACKGROUND) {
+        backgroundLane.append(request);
+    } else {
+        interactiveLane.append(request);
+    }
+    dispatch();
+}
+
+void RequestScheduler::promote(const QUrl &url) {
+    for (int i = 0; i < backgroundLane.size(); i++) {
+        if (backgroundLane.at(i).url() == url) {
+            interactiveLane.append(backgroundLane.takeAt(i));
+            dispatch();
+            return;
+        }
+    }
+}
+
+void RequestScheduler::cancel(const QUrl &url) {
+    for (QList<QNetworkRequest> *lane : {&interactiveLane, &backgroundLane}) {
+        for (int i = 0; i < lane->size(); i++) {
+            if (lane->at(i).url() == url) {
+                lane->removeAt(i);
+                return;
+            }
+        }
+    }
+}
+
+TokenBucket &RequestScheduler::tokenBucketForHost(const QString &host) {
+    if (!tokenBuckets.contains(host)) {
+        tokenBuckets.insert(host, TokenBucket());
+    }
+    return tokenBuckets[host];
+}
+
+void RequestScheduler::dispatch() {
+    qint64 waitMSecs = -1;
+
+    // interactive requests may use all slots and all tokens of a host
+    while (dispatchFromLane(interactiveLane, MAXIMUM_CONCURRENT_REQUESTS, 0, waitMSecs)) {
+    }
+    // background requests leave slots and one token per host for upcoming interactive requests
+    while (dispatchFromLane(backgroundLane,
+                            MAXIMUM_CONCURRENT_REQUESTS - INTERACTIVE_RESERVED_REQUESTS,
+                            1,
+                            waitMSecs)) {
+    }
+
+    // requests are waiting for tokens - try again when the next token is available
+    if (waitMSecs >= 0 && !dispatchTimer.isActive()) {
+        dispatchTimer.start(static_cast<int>(qMax(waitMSecs, static_cast<qint64>(1))));
+    }
+}
+
+bool RequestScheduler::dispatchFromLane(QList<QNetworkRequest> &lane,
+                                        int maximumRunningRequests,
+                                        int reservedTokens,
+                                        qint64 &waitMSecs) {
+    if (runningRequests >= maximumRunningRequests) {
+        return false;
+    }
+
+    const qint64 nowMSecs = clock.elapsed();
+    QSet<QString> rateLimitedHosts;
+
+    // the first request whose host has a token left is started - a rate limited host does not block other hosts
+    for (int i = 0; i < lane.size(); i++) {
+        const QString host = lane.at(i).url().host();
+        if (rateLimitedHosts.contains(host)) {
+            continue;
+        }
+        TokenBucket &tokenBucket = tokenBucketForHost(host);
+        if (tokenBucket.tryConsume(nowMSecs, reservedTokens)) {
+            startRequest(lane.takeAt(i));
+            return true;
+        }
+        rateLimitedHosts.insert(host);
+        const qint64 msecs = tokenBucket.msecsUntilAvailable(nowMSecs, reservedTokens);
+        waitMSecs = (waitMSecs < 0 ? msecs : qMin(waitMSecs, msecs));
+    }
+    return false;
+}
+
+void RequestScheduler::startRequest(const QNetworkRequest &request) {
+    QNetworkReply *reply = manager->get(request);
+    runningRequests++;
+    connect(reply, SIGNAL(finished()), this, SLOT(handleRequestFinished()));
+
+    qCDebug(lcNetwork) << "RequestScheduler::startRequest" << request.url() << "- running :" << runningRequests
+             << ", queued :" << interactiveLane.size() << "/" << backgroundLane.size();
+
+    emit requestStarted(reply);
+}
+
+void RequestScheduler::handleRequestFinished() {
+    runningRequests--;
+    dispatch();
+}
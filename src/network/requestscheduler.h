@@ -0,0 +1,100 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef REQUEST_SCHEDULER_H
+#define REQUEST_SCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QTimer>
+
+// maximum number of requests that are executed at the same time
+const int MAXIMUM_CONCURRENT_REQUESTS = 6;
+// number of the concurrent requests that cannot be used by background requests
+const int INTERACTIVE_RESERVED_REQUESTS = 2;
+// default rate limit for a host
+const double DEFAULT_HOST_REQUESTS_PER_SECOND = 10.0;
+const int DEFAULT_HOST_BURST = 10;
+
+/**
+ * Rate limit for a single host. Tokens are refilled continuously up to the capacity,
+ * each request consumes one token.
+ */
+class TokenBucket {
+public:
+    TokenBucket(double tokensPerSecond = DEFAULT_HOST_REQUESTS_PER_SECOND, int capacity = DEFAULT_HOST_BURST);
+
+    // reservedTokens are left in the bucket - used to keep tokens for interactive requests
+    bool tryConsume(qint64 nowMSecs, int reservedTokens = 0);
+    qint64 msecsUntilAvailable(qint64 nowMSecs, int reservedTokens = 0);
+
+private:
+    double tokensPerSecond;
+    int capacity;
+    double tokens;
+    qint64 lastRefillMSecs = -1;
+
+    void refill(qint64 nowMSecs);
+};
+
+/**
+ * Starts the requests of the NetworkService. The number of concurrent requests is limited and each
+ * host has its own rate limit. Interactive requests (data for the page the user is looking at) are
+ * always started before background requests (e.g. cover refresh).
+ */
+class RequestScheduler : public QObject {
+    Q_OBJECT
+public:
+    enum RequestPriority { INTERACTIVE = 0, BACKGROUND = 1 };
+
+    explicit RequestScheduler(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    ~RequestScheduler() override;
+
+    void enqueue(const QNetworkRequest &request, RequestPriority priority);
+    // moves a queued request to the interactive lane
+    void promote(const QUrl &url);
+    // removes a request that was not started yet
+    void cancel(const QUrl &url);
+    void setHostRateLimit(const QString &host, double requestsPerSecond, int burst);
+
+signals:
+    void requestStarted(QNetworkReply *reply);
+
+private:
+    QNetworkAccessManager *manager;
+    QList<QNetworkRequest> interactiveLane;
+    QList<QNetworkRequest> backgroundLane;
+    QHash<QString, TokenBucket> tokenBuckets;
+    int runningRequests = 0;
+    QTimer dispatchTimer;
+    QElapsedTimer clock;
+
+    TokenBucket &tokenBucketForHost(const QString &host);
+    bool dispatchFromLane(QList<QNetworkRequest> &lane, int maximumRunningRequests, int reservedTokens, qint64 &waitMSecs);
+    void startRequest(const QNetworkRequest &request);
+
+private slots:
+    void dispatch();
+    void handleRequestFinished();
+};
+
+#endif // REQUEST_SCHEDULER_H
@@ -0,0 +1,245 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "responsecache.h"
+#include "../loggingcategories.h"
+#include "../constants.h"
+#include "../marketdata/euroinvestormarketdatabackend.h"
+#include "../newsdata/onvistanews.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+namespace {
+
+// time to live for the different kind of endpoints (in seconds)
+const int TTL_QUOTE = 30;
+const int TTL_INTRADAY = 60;
+const int TTL_CHART = 60 * 60;
+const int TTL_SEARCH = 60 * 60;
+const int TTL_NEWS = 15 * 60;
+const int TTL_DIVIDENDS = 12 * 60 * 60;
+const int TTL_INSTRUMENT_METADATA = 24 * 60 * 60;
+
+// when the cache is full it is cleaned until this percentage of the maximum size is reached
+const int CACHE_CLEANUP_PERCENTAGE = 90;
+
+struct CacheFileEntry
+{
+    QString path;
+    qint64 size;
+    qint64 lastAccess;
+};
+
+} // namespace
+
+ResponseCache::ResponseCache(QObject *parent)
+    : QNetworkDiskCache(parent) {
+    qCDebug(lcNetwork) << "Initializing Response Cache...";
+    setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/network");
+    setMaximumCacheSize(RESPONSE_CACHE_MAXIMUM_SIZE);
+
+    // the first matching policy wins - so more specific url templates have to be added first
+
+    // euroinvestor
+    addPolicy(EUROINVESTOR_API_SEARCH, TTL_SEARCH);
+    addPolicy(EUROINVESTOR_API_QUOTE, TTL_QUOTE);
+    addPolicy(API_MARKET_DATA, TTL_QUOTE);
+    addPolicy(EUROINVESTOR_API_INTRADAY_PRICES, TTL_INTRADAY);
+    addPolicy(EUROINVESTOR_API_CLOSE_PRICES, TTL_CHART);
+
+    // moscow exchange
+    addPolicy(MOSCOW_EXCHANGE_API_SEARCH, TTL_SEARCH);
+    addPolicy(MOSCOW_EXCHANGE_QUOTE, TTL_QUOTE);
+    addPolicy(MOSCOW_EXCHANGE_API_CLOSE_PRICES, TTL_CHART);
+
+    // ing diba
+    addPolicy(ING_DIBA_API_SEARCH, TTL_SEARCH);
+    addPolicy(ING_DIBA_API_QUOTE, TTL_QUOTE);
+    addPolicy(QString(ING_DIBA_API_CHART_PRICES).arg("%1", "Intraday"), TTL_INTRADAY);
+    addPolicy(ING_DIBA_API_CHART_PRICES, TTL_CHART);
+    addPolicy(ING_DIBA_API_PREQUOTE_DATA, TTL_INSTRUMENT_METADATA);
+
+    // news
+    addPolicy(ING_DIBA_NEWS, TTL_NEWS);
+    addPolicy(API_NEWS_SEARCH, TTL_NEWS);
+
+    // dividends
+    addPolicy(DIVVYDIARY_DIVIDENDS, TTL_DIVIDENDS);
+    addPolicy(EXCHANGE_RATES, TTL_DIVIDENDS);
+}
+
+ResponseCache::~ResponseCache() {
+    qCDebug(lcNetwork) << "Shutting down Response Cache...";
+}
+
+int ResponseCache::timeToLive(const QUrl &url) const {
+    const QString urlString = url.toString();
+    for (const CachePolicy &cachePolicy : cachePolicies) {
+        if (cachePolicy.urlPattern.match(urlString).hasMatch()) {
+            return cachePolicy.timeToLive;
+        }
+    }
+    return -1;
+}
+
+QIODevice *ResponseCache::data(const QUrl &url) {
+    QIODevice *device = QNetworkDiskCache::data(url);
+    if (device) {
+        lastAccess.insert(url, QDateTime::currentMSecsSinceEpoch());
+    }
+    return device;
+}
+
+QIODevice *ResponseCache::prepare(const QNetworkCacheMetaData &metaData) {
+    const int ttl = timeToLive(metaData.url());
+    if (ttl < 0) {
+        return QNetworkDiskCache::prepare(metaData);
+    }
+    // error responses (e.g. 429, 503) must not be served from the cache for the whole ttl
+    const QVariant httpStatusCode = metaData.attributes().value(QNetworkRequest::HttpStatusCodeAttribute);
+    if (httpStatusCode.isValid() && httpStatusCode.toInt() != 200) {
+        return nullptr;
+    }
+
+    // the servers mostly answer with no-cache - the expiration is defined by our policy instead.
+    // etag and last-modified are kept, so the entry can be revalidated when it has expired.
+    QNetworkCacheMetaData::RawHeaderList rawHeaders;
+    foreach (const QNetworkCacheMetaData::RawHeader &rawHeader, metaData.rawHeaders()) {
+        const QByteArray headerName = rawHeader.first.toLower();
+        if (headerName != "cache-control" && headerName != "pragma" && headerName != "expires") {
+            rawHeaders.append(rawHeader);
+        }
+    }
+
+    QNetworkCacheMetaData policyMetaData(metaData);
+    policyMetaData.setRawHeaders(rawHeaders);
+    policyMetaData.setSaveToDisk(true);
+    policyMetaData.setExpirationDate(QDateTime::currentDateTimeUtc().addSecs(ttl));
+
+    lastAccess.insert(metaData.url(), QDateTime::currentMSecsSinceEpoch());
+
+    return QNetworkDiskCache::prepare(policyMetaData);
+}
+
+void ResponseCache::insert(QIODevice *device) {
+    if (device && currentCacheSize >= 0) {
+        currentCacheSize += device->size();
+    }
+    QNetworkDiskCache::insert(device);
+}
+
+bool ResponseCache::remove(const QUrl &url) {
+    lastAccess.remove(url);
+    currentCacheSize = -1;
+    return QNetworkDiskCache::remove(url);
+}
+
+void ResponseCache::clear() {
+    lastAccess.clear();
+    QNetworkDiskCache::clear();
+    currentCacheSize = 0;
+}
+
+qint64 ResponseCache::expire() {
+    if (currentCacheSize >= 0 && currentCacheSize < maximumCacheSize()) {
+        return currentCacheSize;
+    }
+
+    if (cacheDirectory().isEmpty()) {
+        return 0;
+    }
+
+    QList<CacheFileEntry> cacheFileEntries;
+    qint64 totalSize = 0;
+
+    QDirIterator it(cacheDirectory(), QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        const QFileInfo info = it.fileInfo();
+        if (info.suffix() != "d") {
+            continue;
+        }
+        CacheFileEntry entry;
+        entry.path = path;
+        entry.size = info.size();
+        entry.lastAccess = info.lastModified().toMSecsSinceEpoch();
+        cacheFileEntries.append(entry);
+        totalSize += entry.size;
+    }
+
+    const qint64 goal = (maximumCacheSize() * CACHE_CLEANUP_PERCENTAGE) / 100;
+    if (totalSize < maximumCacheSize()) {
+        currentCacheSize = totalSize;
+        return totalSize;
+    }
+
+    // the file time only tells when the entry was written - entries read in this session are more recent
+    QMap<QString, QUrl> pathToUrl;
+    for (CacheFileEntry &entry : cacheFileEntries) {
+        const QUrl url = fileMetaData(entry.path).url();
+        pathToUrl.insert(entry.path, url);
+        entry.lastAccess = qMax(entry.lastAccess, lastAccess.value(url, 0));
+    }
+
+    std::sort(cacheFileEntries.begin(),
+              cacheFileEntries.end(),
+              [](const CacheFileEntry &first, const CacheFileEntry &second) {
+                  return first.lastAccess < second.lastAccess;
+              });
+
+    int removedEntries = 0;
+    for (const CacheFileEntry &entry : cacheFileEntries) {
+        if (totalSize <= goal) {
+            break;
+        }
+        if (QFile::remove(entry.path)) {
+            totalSize -= entry.size;
+            lastAccess.remove(pathToUrl.value(entry.path));
+            removedEntries++;
+        }
+    }
+
+    qCDebug(lcNetwork) << "ResponseCache::expire - removed" << removedEntries << "entries, cache size is now" << totalSize;
+
+    currentCacheSize = totalSize;
+    return totalSize;
+}
+
+void ResponseCache::addPolicy(const QString &urlTemplate, int timeToLive) {
+    CachePolicy cachePolicy;
+    cachePolicy.urlPattern = createUrlPattern(urlTemplate);
+    cachePolicy.timeToLive = timeToLive;
+    cachePolicies.append(cachePolicy);
+}
+
+QRegularExpression ResponseCache::createUrlPattern(const QString &urlTemplate) {
+    // the url templates contain placeholders (%1, %2, ...) - they match any value within a path segment / parameter
+    const QStringList urlParts = urlTemplate.split(QRegularExpression("%\\d"));
+    QStringList escapedUrlParts;
+    for (const QString &urlPart : urlParts) {
+        escapedUrlParts.append(QRegularExpression::escape(urlPart));
+    }
+    return QRegularExpression("^" + escapedUrlParts.join("[^/?&]*"));
+}
@@ -0,0 +1,71 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <QHash>
+#include <QList>
+#include <QNetworkDiskCache>
+#include <QRegularExpression>
+#include <QUrl>
+
+// maximum size of the on disk response cache (in bytes)
+const qint64 RESPONSE_CACHE_MAXIMUM_SIZE = 20 * 1024 * 1024;
+
+/**
+ * On disk cache for the responses of all backends. The rest services we use do not send
+ * usable caching headers, so the expiration of each entry is determined by the policy of the
+ * endpoint the response belongs to. Expired entries are revalidated by the network access manager
+ * (ETag / Last-Modified) and the least recently used entries are removed when the cache is full.
+ */
+class ResponseCache : public QNetworkDiskCache {
+    Q_OBJECT
+public:
+    explicit ResponseCache(QObject *parent = nullptr);
+    ~ResponseCache() override;
+
+    QIODevice *data(const QUrl &url) override;
+    QIODevice *prepare(const QNetworkCacheMetaData &metaData) override;
+    void insert(QIODevice *device) override;
+    bool remove(const QUrl &url) override;
+
+    // time to live in seconds for the given url, -1 if no policy matches
+    int timeToLive(const QUrl &url) const;
+
+public slots:
+    void clear() override;
+
+protected:
+    qint64 expire() override;
+
+private:
+    struct CachePolicy
+    {
+        QRegularExpression urlPattern;
+        int timeToLive;
+    };
+
+    QList<CachePolicy> cachePolicies;
+    QHash<QUrl, qint64> lastAccess;
+    qint64 currentCacheSize = -1;
+
+    void addPolicy(const QString &urlTemplate, int timeToLive);
+    QRegularExpression createUrlPattern(const QString &urlTemplate);
+};
+
+#endif // RESPONSE_CACHE_H
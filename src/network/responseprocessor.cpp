@@ -0,0 +1,107 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "responseprocessor.h"
+#include "../loggingcategories.h"
+
+#include <QDebug>
+
+void ResponseProcessorWorker::processJob(int jobId,
+                                         const QByteArray &data,
+                                         const ParseFunction &parseFunction,
+                                         const CancelToken &cancelled) {
+    // the gui thread has already forgotten the job - nothing to report
+    if (cancelled->loadAcquire() != 0) {
+        return;
+    }
+    emit jobProcessed(jobId, parseFunction(data));
+}
+
+ResponseProcessor::ResponseProcessor(QObject *parent)
+    : QObject(parent)
+    , worker(new ResponseProcessorWorker()) {
+    qCDebug(lcNetwork) << "Initializing Response Processor...";
+    qRegisterMetaType<ParseFunction>();
+    qRegisterMetaType<CancelToken>();
+
+    worker->moveToThread(&processingThread);
+    connect(&processingThread, SIGNAL(finished()), worker, SLOT(deleteLater()));
+    // both connections are queued - the objects live on different threads
+    connect(this, &ResponseProcessor::jobQueued, worker, &ResponseProcessorWorker::processJob);
+    connect(worker, &ResponseProcessorWorker::jobProcessed, this, &ResponseProcessor::handleJobProcessed);
+
+    processingThread.setObjectName("ResponseProcessor");
+    processingThread.start(QThread::LowPriority);
+}
+
+ResponseProcessor::~ResponseProcessor() {
+    qCDebug(lcNetwork) << "Shutting down Response Processor...";
+    processingThread.quit();
+    processingThread.wait();
+}
+
+void ResponseProcessor::process(const QByteArray &data,
+                                const ParseFunction &parseFunction,
+                                QObject *receiver,
+                                const ResultHandler &resultHandler,
+                                const QString &tag,
+                                const CancelHandler &cancelHandler) {
+    const int jobId = nextJobId++;
+    Job job;
+    job.receiver = receiver;
+    job.resultHandler = resultHandler;
+    job.cancelHandler = cancelHandler;
+    job.tag = tag;
+    job.cancelled = CancelToken(new QAtomicInt(0));
+    jobs.insert(jobId, job);
+
+    emit jobQueued(jobId, data, parseFunction, job.cancelled);
+}
+
+void ResponseProcessor::cancel(const QString &tag) {
+    if (tag.isEmpty()) {
+        return;
+    }
+    QList<Job> cancelledJobs;
+    QMutableHashIterator<int, Job> iterator(jobs);
+    while (iterator.hasNext()) {
+        const Job &job = iterator.next().value();
+        if (job.tag == tag) {
+            job.cancelled->storeRelease(1);
+            cancelledJobs.append(job);
+            iterator.remove();
+        }
+    }
+
+    // the handlers may queue new jobs - they are called after the jobs were removed
+    foreach (const Job &job, cancelledJobs) {
+        if (!job.receiver.isNull() && job.cancelHandler) {
+            job.cancelHandler();
+        }
+    }
+}
+
+void ResponseProcessor::handleJobProcessed(int jobId, const QVariant &result) {
+    if (!jobs.contains(jobId)) {
+        // cancelled while it was parsed
+        return;
+    }
+    const Job job = jobs.take(jobId);
+    if (!job.receiver.isNull()) {
+        job.resultHandler(result);
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef RESPONSE_PROCESSOR_H
+#define RESPONSE_PROCESSOR_H
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QThread>
+#include <QVariant>
+
+#include <functional>
+
+typedef std::function<QVariant(const QByteArray &)> ParseFunction;
+typedef std::function<void(const QVariant &)> ResultHandler;
+// called instead of the result handler when the job is cancelled - releases the state of the request
+typedef std::function<void()> CancelHandler;
+// set by the gui thread when the job is not needed anymore - read by the processing thread
+typedef QSharedPointer<QAtomicInt> CancelToken;
+
+Q_DECLARE_METATYPE(ParseFunction)
+Q_DECLARE_METATYPE(CancelToken)
+
+/**
+ * Lives on the processing thread and executes the parse functions.
+ */
+class ResponseProcessorWorker : public QObject {
+    Q_OBJECT
+public slots:
+    void processJob(int jobId, const QByteArray &data, const ParseFunction &parseFunction, const CancelToken &cancelled);
+
+signals:
+    void jobProcessed(int jobId, const QVariant &result);
+};
+
+/**
+ * Parses large responses (e.g. charts) on a dedicated thread, so the gui thread is not blocked.
+ * The parse function must not modify any state shared with the gui thread. Only the finished
+ * result (e.g. a string or chart series data) is handed back to the thread of the receiver.
+ */
+class ResponseProcessor : public QObject {
+    Q_OBJECT
+public:
+    explicit ResponseProcessor(QObject *parent = nullptr);
+    ~ResponseProcessor() override;
+
+    // the result handler is not called if the receiver was destroyed in the meantime or the jobs of the
+    // request tag were cancelled - the cancel handler is called for a cancelled job instead
+    void process(const QByteArray &data,
+                 const ParseFunction &parseFunction,
+                 QObject *receiver,
+                 const ResultHandler &resultHandler,
+                 const QString &tag = QString(),
+                 const CancelHandler &cancelHandler = CancelHandler());
+    // jobs of the tag that were not parsed yet are skipped, the result handlers of all its jobs are not called
+    void cancel(const QString &tag);
+
+signals:
+    void jobQueued(int jobId, const QByteArray &data, const ParseFunction &parseFunction, const CancelToken &cancelled);
+
+private:
+    struct Job
+    {
+        QPointer<QObject> receiver;
+        ResultHandler resultHandler;
+        CancelHandler cancelHandler;
+        QString tag;
+        CancelToken cancelled;
+    };
+
+    QThread processingThread;
+    ResponseProcessorWorker *worker;
+    QHash<int, Job> jobs;
+    int nextJobId = 0;
+
+private slots:
+    void handleJobProcessed(int jobId, const QVariant &result);
+};
+
+#endif // RESPONSE_PROCESSOR_H
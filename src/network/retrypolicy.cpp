@@ -0,0 +1,123 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "retrypolicy.h"
+#include "../loggingcategories.h"
+
+#include <QDebug>
+#include <QLocale>
+
+bool RetryPolicy::isRetryable(QNetworkReply::NetworkError error, int httpStatusCode) {
+    switch (httpStatusCode) {
+    case 429: // too many requests
+    case 500:
+    case 502:
+    case 503:
+    case 504:
+        return true;
+    default:
+        break;
+    }
+
+    switch (error) {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownNetworkError:
+        return true;
+    default:
+        return false;
+    }
+}
+
+int RetryPolicy::backoffDelay(int attempt) {
+    const int delay = qMin(RETRY_BASE_DELAY_MSECS << qMin(attempt, 16), RETRY_MAXIMUM_DELAY_MSECS);
+    // jitter - requests that failed together are not retried together
+    return delay / 2 + qrand() % (delay / 2 + 1);
+}
+
+qint64 RetryPolicy::retryAfterDelay(const QByteArray &retryAfterHeader, const QDateTime &now) {
+    const QString retryAfter = QString::fromLatin1(retryAfterHeader).trimmed();
+    if (retryAfter.isEmpty()) {
+        return -1;
+    }
+
+    bool isNumber = false;
+    const qint64 seconds = retryAfter.toLongLong(&isNumber);
+    if (isNumber) {
+        return seconds >= 0 ? seconds * 1000 : -1;
+    }
+
+    QDateTime retryAfterDate = QLocale::c().toDateTime(retryAfter, "ddd, dd MMM yyyy hh:mm:ss 'GMT'");
+    if (!retryAfterDate.isValid()) {
+        qCDebug(lcNetwork) << "RetryPolicy::retryAfterDelay - invalid Retry-After header " << retryAfter;
+        return -1;
+    }
+    retryAfterDate.setTimeSpec(Qt::UTC);
+    return qMax(now.msecsTo(retryAfterDate), static_cast<qint64>(0));
+}
+
+bool CircuitBreaker::allowRequest(const QString &host, qint64 nowMSecs) {
+    if (!hostStates.contains(host)) {
+        return true;
+    }
+
+    HostState &hostState = hostStates[host];
+    if (hostState.openUntilMSecs < 0) {
+        return true;
+    }
+    if (nowMSecs < hostState.openUntilMSecs || hostState.probeRunning) {
+        return false;
+    }
+    hostState.probeRunning = true;
+    return true;
+}
+
+bool CircuitBreaker::isOpen(const QString &host, qint64 nowMSecs) const {
+    return hostStates.contains(host) && nowMSecs < hostStates.value(host).openUntilMSecs;
+}
+
+void CircuitBreaker::recordSuccess(const QString &host) {
+    hostStates.remove(host);
+}
+
+void CircuitBreaker::recordFailure(const QString &host, qint64 nowMSecs) {
+    HostState &hostState = hostStates[host];
+    hostState.consecutiveFailures++;
+    if (hostState.probeRunning || hostState.consecutiveFailures >= CIRCUIT_BREAKER_FAILURE_THRESHOLD) {
+        qCDebug(lcNetwork) << "CircuitBreaker::recordFailure - opening circuit for " << host << " after "
+                 << hostState.consecutiveFailures << " failures";
+        hostState.probeRunning = false;
+        // a longer Retry-After of the server is kept
+        hostState.openUntilMSecs = qMax(hostState.openUntilMSecs, nowMSecs + CIRCUIT_BREAKER_OPEN_MSECS);
+    }
+}
+
+void CircuitBreaker::openUntil(const QString &host, qint64 untilMSecs) {
+    HostState &hostState = hostStates[host];
+    hostState.probeRunning = false;
+    hostState.openUntilMSecs = qMax(hostState.openUntilMSecs, untilMSecs);
+}
+
+void CircuitBreaker::releaseProbe(const QString &host) {
+    if (hostStates.contains(host)) {
+        hostStates[host].probeRunning = false;
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef RETRY_POLICY_H
+#define RETRY_POLICY_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QNetworkReply>
+#include <QString>
+
+// number of retries after the first attempt
+const int MAXIMUM_RETRIES = 3;
+const int RETRY_BASE_DELAY_MSECS = 500;
+// a longer Retry-After is not waited for - the host is treated as unavailable instead
+const int RETRY_MAXIMUM_DELAY_MSECS = 30 * 1000;
+
+// consecutive failed requests (after all their retries) until requests to a host fail fast
+const int CIRCUIT_BREAKER_FAILURE_THRESHOLD = 5;
+const int CIRCUIT_BREAKER_OPEN_MSECS = 30 * 1000;
+
+/**
+ * Decides which failed requests are retried and how long to wait before the next attempt.
+ */
+class RetryPolicy {
+public:
+    // transport errors and overloaded servers - a retry may succeed
+    static bool isRetryable(QNetworkReply::NetworkError error, int httpStatusCode);
+    // exponential backoff with jitter - between half and the full delay of the attempt
+    static int backoffDelay(int attempt);
+    // Retry-After is either delay-seconds or an http date, -1 if missing or invalid
+    static qint64 retryAfterDelay(const QByteArray &retryAfterHeader, const QDateTime &now);
+};
+
+/**
+ * Tracks the health of each host. After too many consecutive failures the circuit opens and requests
+ * to the host fail fast. When the open period is over, a single probe request is let through - its
+ * result closes the circuit again or keeps it open for another period.
+ */
+class CircuitBreaker {
+public:
+    bool allowRequest(const QString &host, qint64 nowMSecs);
+    bool isOpen(const QString &host, qint64 nowMSecs) const;
+    void recordSuccess(const QString &host);
+    void recordFailure(const QString &host, qint64 nowMSecs);
+    void openUntil(const QString &host, qint64 untilMSecs);
+    // a cancelled probe request - the next request is the probe
+    void releaseProbe(const QString &host);
+
+private:
+    struct HostState
+    {
+        int consecutiveFailures = 0;
+        qint64 openUntilMSecs = -1;
+        bool probeRunning = false;
+    };
+
+    QHash<QString, HostState> hostStates;
+};
+
+#endif // RETRY_POLICY_H
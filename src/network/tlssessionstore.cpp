@@ -0,0 +1,102 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "tlssessionstore.h"
+#include "../loggingcategories.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QSettings>
+#include <QSsl>
+
+TlsSessionStore::TlsSessionStore(const QString &fileName)
+    : fileName(fileName) {
+    load();
+}
+
+TlsSessionStore::~TlsSessionStore() {
+    if (changed) {
+        save();
+    }
+}
+
+QSslConfiguration TlsSessionStore::sslConfiguration(const QString &host,
+                                                    const QSslConfiguration &baseConfiguration,
+                                                    const QDateTime &now) const {
+    QSslConfiguration configuration(baseConfiguration);
+    // without session persistence qt does not hand out the session ticket of a connection
+    configuration.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+
+    const TlsSession tlsSession = tlsSessions.value(host);
+    if (!tlsSession.sessionTicket.isEmpty() && now < tlsSession.expiry) {
+        configuration.setSessionTicket(tlsSession.sessionTicket);
+    }
+    return configuration;
+}
+
+void TlsSessionStore::update(const QString &host,
+                             const QByteArray &sessionTicket,
+                             int lifetimeHintSeconds,
+                             const QDateTime &now) {
+    if (sessionTicket.isEmpty() || tlsSessions.value(host).sessionTicket == sessionTicket) {
+        return;
+    }
+
+    TlsSession tlsSession;
+    tlsSession.sessionTicket = sessionTicket;
+    tlsSession.expiry = now.addSecs(lifetimeHintSeconds > 0 ? lifetimeHintSeconds : TLS_SESSION_DEFAULT_LIFETIME_SECONDS);
+    tlsSessions.insert(host, tlsSession);
+    changed = true;
+}
+
+bool TlsSessionStore::hasChanges() const {
+    return changed;
+}
+
+void TlsSessionStore::load() {
+    QSettings storage(fileName, QSettings::IniFormat);
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    foreach (const QString &host, storage.childGroups()) {
+        storage.beginGroup(host);
+        TlsSession tlsSession;
+        tlsSession.sessionTicket = QByteArray::fromBase64(storage.value("ticket").toByteArray());
+        tlsSession.expiry = storage.value("expiry").toDateTime();
+        storage.endGroup();
+
+        if (!tlsSession.sessionTicket.isEmpty() && now < tlsSession.expiry) {
+            tlsSessions.insert(host, tlsSession);
+        }
+    }
+    qCDebug(lcNetwork) << "TlsSessionStore::load - sessions for " << tlsSessions.keys();
+}
+
+void TlsSessionStore::save() {
+    changed = false;
+    QSettings storage(fileName, QSettings::IniFormat);
+    storage.clear();
+    QHashIterator<QString, TlsSession> iterator(tlsSessions);
+    while (iterator.hasNext()) {
+        iterator.next();
+        storage.beginGroup(iterator.key());
+        storage.setValue("ticket", iterator.value().sessionTicket.toBase64());
+        storage.setValue("expiry", iterator.value().expiry);
+        storage.endGroup();
+    }
+    storage.sync();
+    // the tickets allow to resume the sessions - nobody else needs to read them
+    QFile::setPermissions(fileName, QFile::ReadOwner | QFile::WriteOwner);
+}
@@ -0,0 +1,65 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef TLS_SESSION_STORE_H
+#define TLS_SESSION_STORE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QSslConfiguration>
+#include <QString>
+
+// lifetime of a session ticket if the server does not send a hint
+const int TLS_SESSION_DEFAULT_LIFETIME_SECONDS = 2 * 60 * 60;
+// new tickets are written together - a refresh renews the tickets of several hosts within a few seconds
+const int TLS_SESSION_SAVE_DELAY_MSECS = 10 * 1000;
+
+/**
+ * Keeps the tls session ticket of each host on disk, so the first connection after an app start can
+ * resume the session instead of doing a full handshake. New tickets are only kept in memory until save()
+ * is called - unsaved tickets are written when the store is destroyed.
+ */
+class TlsSessionStore {
+public:
+    explicit TlsSessionStore(const QString &fileName);
+    ~TlsSessionStore();
+
+    // the base configuration with the stored session of the host (if not expired)
+    QSslConfiguration sslConfiguration(const QString &host,
+                                       const QSslConfiguration &baseConfiguration,
+                                       const QDateTime &now) const;
+    void update(const QString &host, const QByteArray &sessionTicket, int lifetimeHintSeconds, const QDateTime &now);
+    // true if a ticket was updated since the last save
+    bool hasChanges() const;
+    void save();
+
+private:
+    struct TlsSession
+    {
+        QByteArray sessionTicket;
+        QDateTime expiry;
+    };
+
+    QString fileName;
+    QHash<QString, TlsSession> tlsSessions;
+    bool changed = false;
+
+    void load();
+};
+
+#endif // TLS_SESSION_STORE_H
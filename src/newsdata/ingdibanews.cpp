@@ -16,6 +16,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "ingdibanews.h"
+#include "../loggingcategories.h"
+#include "newscontentfilter.h"
 #include "../constants.h"
 #include "../ingdibautils.h"
 
@@ -25,18 +27,18 @@
 #include <QJsonObject>
 #include <QUrl>
 
-IngDibaNews::IngDibaNews(QNetworkAccessManager *manager, QObject *parent)
+IngDibaNews::IngDibaNews(NetworkService *networkService, QObject *parent)
     : QObject(parent) {
-    qDebug() << "Initializing IngDiba News...";
-    this->manager = manager;
+    qCDebug(lcNews) << "Initializing IngDiba News...";
+    this->networkService = networkService;
 }
 
 IngDibaNews::~IngDibaNews() {
-    qDebug() << "Shutting down IngDiba News...";
+    qCDebug(lcNews) << "Shutting down IngDiba News...";
 }
 
 void IngDibaNews::searchStockNews(const QString &isin) {
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(ING_DIBA_NEWS).arg(isin).arg(1))); // pageNumber 1
+    PendingReply *reply = executeGetRequest(QUrl(QString(ING_DIBA_NEWS).arg(isin).arg(1))); // pageNumber 1
 
     connect(reply,
             SIGNAL(error(QNetworkReply::NetworkError)),
@@ -45,17 +47,17 @@ void IngDibaNews::searchStockNews(const QString &isin) {
     connect(reply, SIGNAL(finished()), this, SLOT(handleSearchStockNews()));
 }
 
-QNetworkReply *IngDibaNews::executeGetRequest(const QUrl &url) {
-    qDebug() << "IngDibaNews::executeGetRequest " << url;
+PendingReply *IngDibaNews::executeGetRequest(const QUrl &url) {
+    qCDebug(lcNews) << "IngDibaNews::executeGetRequest " << url;
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::UserAgentHeader, USER_AGENT);
 
-    return manager->get(request);
+    return networkService->get(request);
 }
 
 void IngDibaNews::handleSearchStockNews() {
-    qDebug() << "IngDibaNews::handleSearchStockNews";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcNews) << "IngDibaNews::handleSearchStockNews";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
@@ -85,9 +87,9 @@ QString IngDibaNews::processSearchResult(QByteArray searchReply) {
             resultObject.insert("content", filterContent(content));
             resultObject.insert("source", source);
             resultObject.insert("url", url);
+            // text format of the local time zone - without the offset
             resultObject.insert("dateTime",
-                                IngDibaUtils::convertTimestampToLocalTimestamp(dateTime, QTimeZone::systemTimeZone())
-                                    .toString());
+                                IngDibaUtils::convertTimestampToLocalTimestamp(dateTime).toLocalTime().toString());
 
             // TODO evtl. html tags filtern -  Link-Tags entfernen <a>
 
@@ -108,16 +110,12 @@ QString IngDibaNews::processSearchResult(QByteArray searchReply) {
 }
 
 QString IngDibaNews::filterContent(QString &content) {
-    QRegExp allTagsRegExp("<[^>]*>");
-    QRegExp whiteSpaces("[\\s\\n]+");
-    content.replace(allTagsRegExp, " ");
-    content.replace(whiteSpaces, " ");
-    return content;
+    return NewsContentFilter::filter(content);
 }
 
 void IngDibaNews::handleRequestError(QNetworkReply::NetworkError error) {
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    qWarning() << "IngDibaNews::handleRequestError:" << static_cast<int>(error) << reply->errorString()
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
+    qCWarning(lcNews) << "IngDibaNews::handleRequestError:" << static_cast<int>(error) << reply->errorString()
                << reply->readAll();
 
     emit requestError("Return code: " + QString::number(static_cast<int>(error)) + " - " + reply->errorString());
@@ -18,14 +18,15 @@
 #ifndef ING_DIBA_NEWS_H
 #define ING_DIBA_NEWS_H
 
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
 
+#include "../network/networkservice.h"
+
 class IngDibaNews : public QObject {
     Q_OBJECT
 public:
-    explicit IngDibaNews(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    explicit IngDibaNews(NetworkService *networkService, QObject *parent = nullptr);
     ~IngDibaNews() override;
     Q_INVOKABLE void searchStockNews(const QString &isin);
 
@@ -40,8 +41,8 @@ protected:
 public slots:
 
 private:
-    QNetworkAccessManager *manager;
-    QNetworkReply *executeGetRequest(const QUrl &url);
+    NetworkService *networkService;
+    PendingReply *executeGetRequest(const QUrl &url);
     QString filterContent(QString &content);
 
 private slots:
@@ -49,7 +50,7 @@ private slots:
     void handleSearchStockNews();
 
 #ifdef UNIT_TEST
-    friend class IngDibaBackendTests; // to test non public methods
+    friend class IngDibaNewsTests; // to test non public methods
 #endif
 };
 
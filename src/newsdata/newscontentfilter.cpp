@@ -0,0 +1,169 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "newscontentfilter.h"
+
+namespace {
+// longest entity we decode - e.g. "&#x20AC;"
+const int MAXIMUM_ENTITY_LENGTH = 10;
+
+struct NamedEntity
+{
+    const char *name;
+    ushort character;
+};
+
+const NamedEntity NAMED_ENTITIES[] = {{"amp", '&'},
+                                      {"lt", '<'},
+                                      {"gt", '>'},
+                                      {"quot", '"'},
+                                      {"apos", '\''},
+                                      {"nbsp", ' '},
+                                      {"euro", 0x20AC},
+                                      {"auml", 0xE4},
+                                      {"ouml", 0xF6},
+                                      {"uuml", 0xFC},
+                                      {"Auml", 0xC4},
+                                      {"Ouml", 0xD6},
+                                      {"Uuml", 0xDC},
+                                      {"szlig", 0xDF}};
+
+bool isTagName(const QChar *data, int length, int position, const char *name) {
+    for (; *name; name++, position++) {
+        if (position >= length || data[position].toLower() != QLatin1Char(*name)) {
+            return false;
+        }
+    }
+    // "<tablex>" is no table
+    return position >= length || !data[position].isLetterOrNumber();
+}
+
+bool equalsName(const QChar *data, int start, int end, const char *name) {
+    int i = start;
+    for (; i < end && *name; i++, name++) {
+        if (data[i] != QLatin1Char(*name)) {
+            return false;
+        }
+    }
+    return i == end && !*name;
+}
+} // namespace
+
+QString NewsContentFilter::filter(const QString &content) {
+    const QChar *data = content.constData();
+    const int length = content.length();
+
+    // the plain text is never longer than the html content
+    QString result(length, Qt::Uninitialized);
+    QChar *output = result.data();
+    int outputLength = 0;
+
+    int tableDepth = 0;
+    // a '<' without a following '>' is text - no need to search again after the first miss
+    bool hasTagEnd = true;
+    int position = 0;
+
+    while (position < length) {
+        const QChar character = data[position];
+
+        if (character == QLatin1Char('<') && hasTagEnd) {
+            const int tagEnd = skipTag(data, length, position, tableDepth);
+            if (tagEnd >= 0) {
+                position = tagEnd;
+                if (tableDepth == 0 && (outputLength == 0 || output[outputLength - 1] != QLatin1Char(' '))) {
+                    output[outputLength++] = QLatin1Char(' ');
+                }
+                continue;
+            }
+            hasTagEnd = false;
+        }
+
+        position++;
+        if (tableDepth > 0) {
+            continue;
+        }
+
+        QChar decoded = character;
+        if (character == QLatin1Char('&')) {
+            const int entityEnd = decodeEntity(data, length, position - 1, decoded);
+            if (entityEnd >= 0) {
+                position = entityEnd;
+            }
+        }
+
+        if (decoded.isSpace()) {
+            if (outputLength == 0 || output[outputLength - 1] != QLatin1Char(' ')) {
+                output[outputLength++] = QLatin1Char(' ');
+            }
+        } else {
+            output[outputLength++] = decoded;
+        }
+    }
+
+    result.truncate(outputLength);
+    return result;
+}
+
+int NewsContentFilter::skipTag(const QChar *data, int length, int position, int &tableDepth) {
+    int tagEnd = position + 1;
+    while (tagEnd < length && data[tagEnd] != QLatin1Char('>')) {
+        tagEnd++;
+    }
+    if (tagEnd >= length) {
+        return -1;
+    }
+
+    if (isTagName(data, length, position + 1, "table")) {
+        tableDepth++;
+    } else if (tableDepth > 0 && data[position + 1] == QLatin1Char('/')
+               && isTagName(data, length, position + 2, "table")) {
+        tableDepth--;
+    }
+    return tagEnd + 1;
+}
+
+int NewsContentFilter::decodeEntity(const QChar *data, int length, int position, QChar &decoded) {
+    int entityEnd = position + 1;
+    while (entityEnd < length && entityEnd - position <= MAXIMUM_ENTITY_LENGTH && data[entityEnd] != QLatin1Char(';')) {
+        entityEnd++;
+    }
+    if (entityEnd >= length || data[entityEnd] != QLatin1Char(';') || entityEnd == position + 1) {
+        return -1;
+    }
+
+    const int nameStart = position + 1;
+    if (data[nameStart] == QLatin1Char('#')) {
+        // numeric entity - decimal or hexadecimal
+        const bool hexadecimal = (nameStart + 1 < entityEnd && data[nameStart + 1].toLower() == QLatin1Char('x'));
+        bool ok = false;
+        const int digitsStart = nameStart + (hexadecimal ? 2 : 1);
+        const uint code = QString::fromRawData(data + digitsStart, entityEnd - digitsStart).toUInt(&ok, hexadecimal ? 16 : 10);
+        if (!ok || code == 0 || code > 0xFFFF) {
+            return -1;
+        }
+        decoded = QChar(static_cast<ushort>(code));
+        return entityEnd + 1;
+    }
+
+    for (const NamedEntity &entity : NAMED_ENTITIES) {
+        if (equalsName(data, nameStart, entityEnd, entity.name)) {
+            decoded = QChar(entity.character);
+            return entityEnd + 1;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,38 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NEWS_CONTENT_FILTER_H
+#define NEWS_CONTENT_FILTER_H
+
+#include <QString>
+
+/**
+ * Converts the html content of news to plain text in a single pass: tags are replaced by a space, tables
+ * (e.g. godmode trader data) are dropped, common entities are decoded and whitespace is collapsed.
+ */
+class NewsContentFilter {
+public:
+    static QString filter(const QString &content);
+
+private:
+    // returns the position after the tag - or -1 if the tag is not closed
+    static int skipTag(const QChar *data, int length, int position, int &tableDepth);
+    // returns the position after the entity - or -1 if it is not a known entity
+    static int decodeEntity(const QChar *data, int length, int position, QChar &decoded);
+};
+
+#endif // NEWS_CONTENT_FILTER_H
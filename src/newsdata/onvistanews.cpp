@@ -16,6 +16,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "onvistanews.h"
+#include "../loggingcategories.h"
+#include "newscontentfilter.h"
 
 #include <QDebug>
 #include <QJsonArray>
@@ -23,18 +25,18 @@
 #include <QJsonObject>
 #include <QUrl>
 
-OnvistaNews::OnvistaNews(QNetworkAccessManager *manager, QObject *parent)
+OnvistaNews::OnvistaNews(NetworkService *networkService, QObject *parent)
     : QObject(parent) {
-    qDebug() << "Initializing Onvista News...";
-    this->manager = manager;
+    qCDebug(lcNews) << "Initializing Onvista News...";
+    this->networkService = networkService;
 }
 
 OnvistaNews::~OnvistaNews() {
-    qDebug() << "Shutting down Onvista News...";
+    qCDebug(lcNews) << "Shutting down Onvista News...";
 }
 
 void OnvistaNews::searchStockNews(const QString &isin) {
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(API_NEWS_SEARCH).arg(isin).arg(15)));
+    PendingReply *reply = executeGetRequest(QUrl(QString(API_NEWS_SEARCH).arg(isin).arg(15)));
 
     connect(reply,
             SIGNAL(error(QNetworkReply::NetworkError)),
@@ -43,17 +45,17 @@ void OnvistaNews::searchStockNews(const QString &isin) {
     connect(reply, SIGNAL(finished()), this, SLOT(handleSearchStockNews()));
 }
 
-QNetworkReply *OnvistaNews::executeGetRequest(const QUrl &url) {
-    qDebug() << "OnvistaNews::executeGetRequest " << url;
+PendingReply *OnvistaNews::executeGetRequest(const QUrl &url) {
+    qCDebug(lcNews) << "OnvistaNews::executeGetRequest " << url;
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::UserAgentHeader, NEWS_USER_AGENT);
 
-    return manager->get(request);
+    return networkService->get(request);
 }
 
 void OnvistaNews::handleSearchStockNews() {
-    qDebug() << "OnvistaNews::handleSearchStockNews";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcNews) << "OnvistaNews::handleSearchStockNews";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
@@ -106,18 +108,13 @@ void OnvistaNews::handleSearchStockNews() {
 }
 
 QString OnvistaNews::filterContent(QString &content) {
-    QRegExp allTagsRegExp("<[^>]*>");
-    QRegExp godmodeTraderTableRegExp("<table>(.*)</table>");
-    content.replace(godmodeTraderTableRegExp, " ");
-    content.replace(allTagsRegExp, " ");
-    content.replace("&amp;", "&");
-
-    return content;
+    // also drops the tables of the godmode trader data
+    return NewsContentFilter::filter(content);
 }
 
 void OnvistaNews::handleRequestError(QNetworkReply::NetworkError error) {
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    qWarning() << "OnvistaNews::handleRequestError:" << static_cast<int>(error) << reply->errorString()
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
+    qCWarning(lcNews) << "OnvistaNews::handleRequestError:" << static_cast<int>(error) << reply->errorString()
                << reply->readAll();
 
     emit requestError("Return code: " + QString::number(static_cast<int>(error)) + " - " + reply->errorString());
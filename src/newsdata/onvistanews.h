@@ -1,10 +1,11 @@
 #ifndef ONVISTA_NEWS_H
 #define ONVISTA_NEWS_H
 
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
 
+#include "../network/networkservice.h"
+
 const char API_NEWS_SEARCH[]
     = "https://m.onvista.de/news/boxes/newslist/snapshot.json?assetId=%1&offset=0&blocksize=%2";
 const char NEWS_USER_AGENT[] = "Mozilla/5.0 (X11; Ubuntu; Linux x86_64; rv:73.0) Gecko/20100101 Firefox/73.0";
@@ -12,7 +13,7 @@ const char NEWS_USER_AGENT[] = "Mozilla/5.0 (X11; Ubuntu; Linux x86_64; rv:73.0)
 class OnvistaNews : public QObject {
     Q_OBJECT
 public:
-    explicit OnvistaNews(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    explicit OnvistaNews(NetworkService *networkService, QObject *parent = nullptr);
     ~OnvistaNews();
     Q_INVOKABLE void searchStockNews(const QString &isin);
 
@@ -25,8 +26,8 @@ protected:
 public slots:
 
 private:
-    QNetworkAccessManager *manager;
-    QNetworkReply *executeGetRequest(const QUrl &url);
+    NetworkService *networkService;
+    PendingReply *executeGetRequest(const QUrl &url);
     QString filterContent(QString &content);
 
 private slots:
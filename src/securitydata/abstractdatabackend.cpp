@@ -16,39 +16,103 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "abstractdatabackend.h"
+#include "../loggingcategories.h"
 #include "../constants.h"
 
 #include <QDebug>
-#include <QJsonArray>
-#include <QJsonDocument>
-#include <QJsonObject>
 
-AbstractDataBackend::AbstractDataBackend(QNetworkAccessManager *manager, QObject *parent)
+AbstractDataBackend::AbstractDataBackend(NetworkService *networkService, QObject *parent)
     : QObject(parent) {
-    qDebug() << "Initializing Data Backend...";
-    this->manager = manager;
+    qCDebug(lcParse) << "Initializing Data Backend...";
+    this->networkService = networkService;
+    qRegisterMetaType<ChartSeries *>();
 }
 
 AbstractDataBackend::~AbstractDataBackend() {
-    qDebug() << "Shutting down AbstractDataBackend...";
+    qCDebug(lcParse) << "Shutting down AbstractDataBackend...";
 }
 
-QNetworkReply *AbstractDataBackend::executeGetRequest(const QUrl &url) {
-    qDebug() << "AbstractDataBackend::executeGetRequest " << url;
+PendingReply *AbstractDataBackend::executeGetRequest(const QUrl &url,
+                                                     const int requestId,
+                                                     RequestScheduler::RequestPriority priority) {
+    qCDebug(lcNetwork) << "AbstractDataBackend::executeGetRequest " << url;
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::ContentTypeHeader, MIME_TYPE_JSON);
     request.setHeader(QNetworkRequest::UserAgentHeader, USER_AGENT);
 
-    return manager->get(request);
+    PendingReply *reply = networkService->get(request, priority);
+    reply->setProperty(NETWORK_REPLY_PROPERTY_REQUEST_ID, requestId);
+    if (requestId != 0) {
+        connect(reply, &PendingReply::finished, this, [this, reply, requestId]() {
+            if (reply->error() != QNetworkReply::NoError) {
+                discardRequest(requestId);
+            }
+        });
+    }
+    return reply;
+}
+
+int AbstractDataBackend::requestIdOf(const PendingReply *reply) const {
+    return reply->property(NETWORK_REPLY_PROPERTY_REQUEST_ID).toInt();
+}
+
+int AbstractDataBackend::requestSearchName(const QString &searchString, const QJSValue &callback) {
+    const int requestId = registerRequest(callback);
+    searchName(searchString, requestId);
+    return requestId;
+}
+
+int AbstractDataBackend::requestPricesForChart(const QString &extRefId, const int chartType, const QJSValue &callback) {
+    if (!isChartTypeSupported(chartType)) {
+        qCDebug(lcChart) << "AbstractDataBackend::requestPricesForChart - chart type" << chartType << "not supported!";
+        return 0;
+    }
+    const int requestId = registerRequest(callback);
+    fetchPricesForChart(extRefId, chartType, requestId);
+    return requestId;
+}
+
+int AbstractDataBackend::registerRequest(const QJSValue &callback) {
+    const int requestId = ++lastRequestId;
+    RequestCallback requestCallback;
+    requestCallback.callback = callback;
+    // the caller has just called this backend - so the backend is known to the engine of the caller
+    requestCallback.engine = qjsEngine(this);
+    requestCallbacks.insert(requestId, requestCallback);
+    return requestId;
+}
+
+void AbstractDataBackend::discardRequest(const int requestId) {
+    requestCallbacks.remove(requestId);
 }
 
-void AbstractDataBackend::connectErrorSlot(QNetworkReply *reply) {
+void AbstractDataBackend::invokeCallback(RequestCallback requestCallback, const QJSValueList &arguments) {
+    const QJSValue result = requestCallback.callback.call(arguments);
+    if (result.isError()) {
+        qCWarning(lcParse) << "AbstractDataBackend::invokeCallback -" << result.toString();
+    }
+}
+
+void AbstractDataBackend::deliverSearchResult(const int requestId, const QString &searchResult) {
+    const RequestCallback requestCallback = requestCallbacks.take(requestId);
+    if (!requestCallback.callback.isCallable()) {
+        return;
+    }
+    invokeCallback(requestCallback, QJSValueList() << QJSValue(searchResult));
+}
+
+PendingReply *AbstractDataBackend::fetchQuoteBatch(const QStringList &extRefIds,
+                                                  RequestScheduler::RequestPriority priority) {
+    return executeQuoteBatchRequest(extRefIds, priority);
+}
+
+void AbstractDataBackend::connectErrorSlot(PendingReply *reply) {
     // connect the error and also emit the error signal via a lambda expression
     connect(reply,
-            static_cast<void (QNetworkReply::*)(QNetworkReply::NetworkError)>(&QNetworkReply::error),
+            static_cast<void (PendingReply::*)(QNetworkReply::NetworkError)>(&PendingReply::error),
             [=](QNetworkReply::NetworkError error) {
                 // TODO test reply->deleteLater();
-                qWarning() << "AbstractDataBackend::handleRequestError:" << static_cast<int>(error)
+                qCWarning(lcNetwork) << "AbstractDataBackend::handleRequestError:" << static_cast<int>(error)
                            << reply->errorString() << reply->readAll();
                 emit requestError("Return code: " + QString::number(static_cast<int>(error)) + " - "
                                   + reply->errorString());
@@ -88,23 +152,30 @@ bool AbstractDataBackend::isChartTypeSupported(const int chartTypeToCheck) {
     return (chartTypeToCheck == (supportedChartTypes & chartTypeToCheck));
 }
 
-QJsonObject AbstractDataBackend::createChartDataPoint(qint64 mSecsSinceEpoch, double priceValue) {
-    QJsonObject resultObject;
-    resultObject.insert("x", mSecsSinceEpoch / 1000);
-    resultObject.insert("y", priceValue);
-    return resultObject;
+void AbstractDataBackend::deliverChartSeries(const int requestId,
+                                             const QVariant &chartSeriesData,
+                                             const int chartType) {
+    const RequestCallback requestCallback = requestCallbacks.take(requestId);
+    // the series is only created for a caller - it is owned by the engine and garbage collected when the chart
+    // page does not need it anymore
+    if (!chartSeriesData.isValid() || requestCallback.engine.isNull() || !requestCallback.callback.isCallable()) {
+        return;
+    }
+    ChartSeries *chartSeries = new ChartSeries(chartSeriesData.value<ChartSeriesData>());
+    invokeCallback(requestCallback,
+                   QJSValueList() << requestCallback.engine->newQObject(chartSeries) << chartType << -1);
 }
 
-QString AbstractDataBackend::createChartResponseString(QJsonArray resultArray, ChartDataCalculator chartDataCalculator) {
-    QJsonObject resultObject;
-    resultObject.insert("min", chartDataCalculator.getMinValue());
-    resultObject.insert("max", chartDataCalculator.getMaxValue());
-    resultObject.insert("fractionDigits", chartDataCalculator.getFractionDigits());
-    resultObject.insert("data", resultArray);
-
-    QJsonDocument resultDocument;
-    resultDocument.setObject(resultObject);
-
-    QString dataToString(resultDocument.toJson());
-    return dataToString;
+void AbstractDataBackend::deliverChartSeriesAppended(const int requestId,
+                                                     const ChartSeriesData &chartSeriesData,
+                                                     const int appendedCount,
+                                                     const int chartType) {
+    const RequestCallback requestCallback = requestCallbacks.take(requestId);
+    if (requestCallback.engine.isNull() || !requestCallback.callback.isCallable()) {
+        return;
+    }
+    // the series shares its arrays with chartSeriesData - nothing is copied
+    ChartSeries *chartSeries = new ChartSeries(chartSeriesData);
+    invokeCallback(requestCallback,
+                   QJSValueList() << requestCallback.engine->newQObject(chartSeries) << chartType << appendedCount);
 }
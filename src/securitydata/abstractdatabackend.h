@@ -18,32 +18,21 @@
 #ifndef ABSTRACTDATABACKEND_H
 #define ABSTRACTDATABACKEND_H
 
-#include <QNetworkAccessManager>
+#include <QHash>
+#include <QJSEngine>
+#include <QJSValue>
+#include <QJsonArray>
 #include <QNetworkReply>
 #include <QObject>
+#include <QPointer>
+#include <QStringList>
 
-#include "chartdatacalculator.h"
+#include "../network/networkservice.h"
+#include "chartseries.h"
 
 class AbstractDataBackend : public QObject {
     Q_OBJECT
 public:
-    explicit AbstractDataBackend(QNetworkAccessManager *manager, QObject *parent = nullptr);
-    ~AbstractDataBackend() = 0;
-
-    Q_INVOKABLE virtual void searchName(const QString &searchString) = 0;
-    Q_INVOKABLE virtual void searchQuote(const QString &searchString) = 0;
-    Q_INVOKABLE virtual void fetchPricesForChart(const QString &extRefId, const int chartType) = 0;
-    Q_INVOKABLE bool isChartTypeSupported(const int chartTypeToCheck);
-
-    // signals for the qml part
-    Q_SIGNAL void searchResultAvailable(const QString &reply);
-    Q_SIGNAL void quoteResultAvailable(const QString &reply);
-    Q_SIGNAL void fetchPricesForChartAvailable(const QString &reply, const int chartType);
-    Q_SIGNAL void requestError(const QString &errorMessage);
-
-protected:
-    QNetworkAccessManager *manager;
-
     // also update constants in constants.js when you add entries / change values !
     enum ChartType {
         NONE = 0,
@@ -57,19 +46,75 @@ protected:
         MAXIMUM = 128
     };
 
+    explicit AbstractDataBackend(NetworkService *networkService, QObject *parent = nullptr);
+    ~AbstractDataBackend() = 0;
+
+    // requestId is the id returned by requestSearchName and requestPricesForChart - follow-up requests pass it on
+    virtual void searchName(const QString &searchString, const int requestId) = 0;
+    virtual void fetchPricesForChart(const QString &extRefId, const int chartType, const int requestId) = 0;
+    Q_INVOKABLE bool isChartTypeSupported(const int chartTypeToCheck);
+    // the result is only handed to the callback of the caller - callback(searchResult) with the json string of the
+    // search result, callback(chartSeries, chartType, appendedCount) with appendedCount < 0 for a new series and the
+    // number of new points at the end of the previous series otherwise. Returns the request id.
+    Q_INVOKABLE int requestSearchName(const QString &searchString, const QJSValue &callback);
+    Q_INVOKABLE int requestPricesForChart(const QString &extRefId, const int chartType, const QJSValue &callback);
+
+    // quote requests of the QuoteService - splits the ids into the requests the api needs (one id list per request)
+    virtual QList<QStringList> splitQuoteBatches(const QStringList &extRefIds) = 0;
+    PendingReply *fetchQuoteBatch(const QStringList &extRefIds, RequestScheduler::RequestPriority priority);
+    // quotes of a quote request, one json object per security - called on the processing thread
+    virtual QJsonArray parseQuoteBatch(const QByteArray &quoteReply) = 0;
+
+    // signals for the qml part
+    Q_SIGNAL void requestError(const QString &errorMessage);
+
+protected:
+    NetworkService *networkService;
+
     int supportedChartTypes = ChartType::NONE;
 
     virtual QString convertCurrency(const QString &currencyString) = 0;
 
-    QJsonObject createChartDataPoint(qint64 mSecsSinceEpoch, double priceValue);
-    QString createChartResponseString(QJsonArray resultArray, ChartDataCalculator chartDataCalculator);
+    // hand the result of a request to the callback of its caller - each request delivers one result, the chart
+    // series data created by a parse function is dropped if it is invalid
+    void deliverSearchResult(const int requestId, const QString &searchResult);
+    void deliverChartSeries(const int requestId, const QVariant &chartSeriesData, const int chartType);
+    void deliverChartSeriesAppended(const int requestId,
+                                    const ChartSeriesData &chartSeriesData,
+                                    const int appendedCount,
+                                    const int chartType);
+    // the request will not deliver a result (e.g. superseded by a newer request)
+    void discardRequest(const int requestId);
+    int requestIdOf(const PendingReply *reply) const;
 
-    QNetworkReply *executeGetRequest(const QUrl &url);
+    // the request id is stored in the reply - a failed reply discards the request
+    PendingReply *executeGetRequest(const QUrl &url,
+                                    const int requestId = 0,
+                                    RequestScheduler::RequestPriority priority = RequestScheduler::INTERACTIVE);
+    virtual PendingReply *executeQuoteBatchRequest(const QStringList &extRefIds,
+                                                   RequestScheduler::RequestPriority priority) = 0;
     QDate getStartDateForChart(const int chartType);
     QString convertToDatabaseDateTimeFormat(const QDateTime &time);
-    void connectErrorSlot(QNetworkReply *reply);
+    void connectErrorSlot(PendingReply *reply);
 
 protected slots:
+
+private:
+    // callback of a qml caller - the results are converted to js values of the engine the caller runs in
+    struct RequestCallback
+    {
+        QJSValue callback;
+        QPointer<QJSEngine> engine;
+    };
+    QHash<int, RequestCallback> requestCallbacks;
+    int lastRequestId = 0;
+
+    int registerRequest(const QJSValue &callback);
+    void invokeCallback(RequestCallback requestCallback, const QJSValueList &arguments);
+
+#ifdef UNIT_TEST
+    friend class IngDibaBackendTests;
+#endif
 };
 
 #endif // ABSTRACTDATABACKEND_H
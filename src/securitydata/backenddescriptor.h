@@ -0,0 +1,181 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BACKEND_DESCRIPTOR_H
+#define BACKEND_DESCRIPTOR_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QLatin1String>
+#include <QString>
+#include <QStringList>
+
+/**
+ * Static description of a data backend - the url templates of the api and the supported chart types.
+ */
+struct BackendDescriptor
+{
+    const char *searchUrl;
+    const char *quoteUrl;
+    const char *chartUrl;
+    // nullptr if the intraday chart is loaded from the chart url
+    const char *intradayChartUrl;
+    int supportedChartTypes;
+};
+
+/**
+ * A field of the search / quote result and where the backend takes it from - the json key of a response
+ * object or the column name of a response table.
+ */
+struct FieldMapping
+{
+    const char *targetKey;
+    const char *sourceKey;
+};
+
+// keys of the search / quote results that are handed to qml
+constexpr const char *const RESULT_KEYS[] = {"extRefId",
+                                             "name",
+                                             "currency",
+                                             "currencySymbol",
+                                             "price",
+                                             "symbol1",
+                                             "isin",
+                                             "stockMarketName",
+                                             "changeAbsolute",
+                                             "changeRelative",
+                                             "high",
+                                             "low",
+                                             "ask",
+                                             "bid",
+                                             "volume",
+                                             "numberOfStocks",
+                                             "quoteTimestamp",
+                                             "lastChangeTimestamp",
+                                             "genericText1"};
+constexpr int RESULT_KEY_COUNT = sizeof(RESULT_KEYS) / sizeof(RESULT_KEYS[0]);
+
+// compile time checks of the mapping tables - used in static_assert
+constexpr bool keysEqual(const char *first, const char *second) {
+    return *first == *second && (*first == '\0' || keysEqual(first + 1, second + 1));
+}
+
+constexpr bool isResultKey(const char *key, int index = 0) {
+    return index < RESULT_KEY_COUNT && (keysEqual(key, RESULT_KEYS[index]) || isResultKey(key, index + 1));
+}
+
+template <int N>
+constexpr bool isTargetKeyUnique(const FieldMapping (&fields)[N], int index, int other) {
+    return other >= N
+           || ((other == index || !keysEqual(fields[index].targetKey, fields[other].targetKey))
+               && isTargetKeyUnique(fields, index, other + 1));
+}
+
+// every target is a result key that is mapped only once and every source is named
+template <int N>
+constexpr bool isValidMapping(const FieldMapping (&fields)[N], int index = 0) {
+    return index >= N
+           || (isResultKey(fields[index].targetKey) && fields[index].sourceKey[0] != '\0'
+               && isTargetKeyUnique(fields, index, 0) && isValidMapping(fields, index + 1));
+}
+
+// every chart type of chartTypes has an entry in the table of a backend (time ranges, candle intervals)
+template <typename ChartTypeEntry, int N>
+constexpr bool coversChartTypes(const ChartTypeEntry (&entries)[N], int chartTypes, int index = 0) {
+    return index >= N ? chartTypes == 0 : coversChartTypes(entries, chartTypes & ~entries[index].chartType, index + 1);
+}
+
+inline int columnIndex(const QJsonArray &columns, const QLatin1String &columnName) {
+    for (int i = 0; i < columns.size(); i++) {
+        if (columns.at(i).toString() == columnName) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Copies the fields of a mapping table from a response element to a result object. The keys are converted once
+ * when the mapper is created - mapping an element is a plain loop over the table.
+ */
+template <typename Source, int N>
+class FieldMapper;
+
+// response elements that are json objects - the source is the key in the object
+template <int N>
+class FieldMapper<QJsonObject, N> {
+public:
+    explicit FieldMapper(const FieldMapping (&fields)[N]) {
+        for (int i = 0; i < N; i++) {
+            targetKeys[i] = QString::fromLatin1(fields[i].targetKey);
+            sourceKeys[i] = QString::fromLatin1(fields[i].sourceKey);
+        }
+    }
+
+    void map(const QJsonObject &source, QJsonObject &result) const {
+        for (int i = 0; i < N; i++) {
+            result.insert(targetKeys[i], source.value(sourceKeys[i]));
+        }
+    }
+
+private:
+    QString targetKeys[N];
+    QString sourceKeys[N];
+};
+
+// rows of a response table - the columns are resolved by name once per response, missing columns are not mapped
+template <int N>
+class FieldMapper<QJsonArray, N> {
+public:
+    FieldMapper(const FieldMapping (&fields)[N], const QJsonArray &columns) {
+        for (int i = 0; i < N; i++) {
+            targetKeys[i] = QString::fromLatin1(fields[i].targetKey);
+            columnIndexes[i] = columnIndex(columns, QLatin1String(fields[i].sourceKey));
+            if (columnIndexes[i] < 0) {
+                missingColumns.append(QString::fromLatin1(fields[i].sourceKey));
+            }
+        }
+    }
+
+    QStringList getMissingColumns() const {
+        return missingColumns;
+    }
+
+    void map(const QJsonArray &row, QJsonObject &result) const {
+        // a missing column results in an undefined value - inserting it does not add the key
+        for (int i = 0; i < N; i++) {
+            result.insert(targetKeys[i], row.at(columnIndexes[i]));
+        }
+    }
+
+private:
+    QString targetKeys[N];
+    int columnIndexes[N];
+    QStringList missingColumns;
+};
+
+template <int N>
+FieldMapper<QJsonObject, N> objectFieldMapper(const FieldMapping (&fields)[N]) {
+    return FieldMapper<QJsonObject, N>(fields);
+}
+
+template <int N>
+FieldMapper<QJsonArray, N> columnFieldMapper(const FieldMapping (&fields)[N], const QJsonArray &columns) {
+    return FieldMapper<QJsonArray, N>(fields, columns);
+}
+
+#endif // BACKEND_DESCRIPTOR_H
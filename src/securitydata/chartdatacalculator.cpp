@@ -14,19 +14,19 @@ void ChartDataCalculator::checkCloseValue(double value) {
     }
 }
 
-double ChartDataCalculator::getMinValue() {
+double ChartDataCalculator::getMinValue() const {
     // top / bottom margin for chart - if the difference is too small - rounding makes no sense.
     double roundedMin = (max - min > 1.0) ? floor(min) : min;
     return roundedMin;
 }
 
-double ChartDataCalculator::getMaxValue() {
+double ChartDataCalculator::getMaxValue() const {
     // top / bottom margin for chart - if the difference is too small - rounding makes no sense.
     double roundedMax = (max - min > 1.0) ? ceil(max) : max;
     return roundedMax;
 }
 
-int ChartDataCalculator::getFractionDigits() {
+int ChartDataCalculator::getFractionDigits() const {
     // determine how many fraction digits the y-axis is supposed to display
     int fractionsDigits = 1;
     if (max - min > 10.0) {
@@ -6,9 +6,9 @@ public:
     ChartDataCalculator() = default;
 
     void checkCloseValue(double value);
-    double getMinValue();
-    double getMaxValue();
-    int getFractionDigits();
+    double getMinValue() const;
+    double getMaxValue() const;
+    int getFractionDigits() const;
 
 private:
     double min = -1.0;
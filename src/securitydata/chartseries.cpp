@@ -0,0 +1,97 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "chartseries.h"
+
+void ChartSeriesData::reserve(int size) {
+    timestamps.reserve(size);
+    values.reserve(size);
+}
+
+void ChartSeriesData::append(qint64 mSecsSinceEpoch, double value) {
+    timestamps.append(mSecsSinceEpoch / 1000);
+    values.append(value);
+    chartDataCalculator.checkCloseValue(value);
+}
+
+void ChartSeriesData::append(const ChartSeriesData &other) {
+    timestamps += other.timestamps;
+    values += other.values;
+    foreach (double value, other.values) {
+        chartDataCalculator.checkCloseValue(value);
+    }
+}
+
+int ChartSeriesData::size() const {
+    return values.size();
+}
+
+QVector<qint64> ChartSeriesData::getTimestamps() const {
+    return timestamps;
+}
+
+QVector<double> ChartSeriesData::getValues() const {
+    return values;
+}
+
+double ChartSeriesData::getMinValue() const {
+    return chartDataCalculator.getMinValue();
+}
+
+double ChartSeriesData::getMaxValue() const {
+    return chartDataCalculator.getMaxValue();
+}
+
+int ChartSeriesData::getFractionDigits() const {
+    return chartDataCalculator.getFractionDigits();
+}
+
+ChartSeries::ChartSeries(const ChartSeriesData &data, QObject *parent)
+    : QObject(parent)
+    , timestamps(data.getTimestamps())
+    , values(data.getValues())
+    , min(data.getMinValue())
+    , max(data.getMaxValue())
+    , fractionDigits(data.getFractionDigits()) {
+}
+
+ChartSeries::~ChartSeries() {
+}
+
+double ChartSeries::timestamp(int index) const {
+    return (index >= 0 && index < timestamps.size()) ? static_cast<double>(timestamps.at(index)) : 0.0;
+}
+
+double ChartSeries::value(int index) const {
+    return (index >= 0 && index < values.size()) ? values.at(index) : 0.0;
+}
+
+int ChartSeries::getCount() const {
+    return values.size();
+}
+
+double ChartSeries::getMin() const {
+    return min;
+}
+
+double ChartSeries::getMax() const {
+    return max;
+}
+
+int ChartSeries::getFractionDigits() const {
+    return fractionDigits;
+}
@@ -0,0 +1,84 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CHART_SERIES_H
+#define CHART_SERIES_H
+
+#include <QMetaType>
+#include <QObject>
+#include <QVariant>
+#include <QVector>
+
+#include "chartdatacalculator.h"
+
+/**
+ * Timestamps and close values of a chart, stored in two contiguous arrays. Filled by the parse functions
+ * on the processing thread - copying it to the gui thread only copies the implicitly shared arrays.
+ */
+class ChartSeriesData {
+public:
+    void reserve(int size);
+    void append(qint64 mSecsSinceEpoch, double value);
+    // appends the points of another series, e.g. the next page of a paginated response
+    void append(const ChartSeriesData &other);
+    int size() const;
+
+    QVector<qint64> getTimestamps() const;
+    QVector<double> getValues() const;
+    double getMinValue() const;
+    double getMaxValue() const;
+    int getFractionDigits() const;
+
+private:
+    // seconds since epoch - the x axis of the chart does not need a higher resolution
+    QVector<qint64> timestamps;
+    QVector<double> values;
+    ChartDataCalculator chartDataCalculator;
+};
+
+Q_DECLARE_METATYPE(ChartSeriesData)
+
+/**
+ * Chart data handed to qml. The points are read by index, so no javascript object is created per point.
+ */
+class ChartSeries : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int count READ getCount CONSTANT)
+    Q_PROPERTY(double min READ getMin CONSTANT)
+    Q_PROPERTY(double max READ getMax CONSTANT)
+    Q_PROPERTY(int fractionDigits READ getFractionDigits CONSTANT)
+public:
+    explicit ChartSeries(const ChartSeriesData &data, QObject *parent = nullptr);
+    ~ChartSeries() override;
+
+    Q_INVOKABLE double timestamp(int index) const;
+    Q_INVOKABLE double value(int index) const;
+
+    int getCount() const;
+    double getMin() const;
+    double getMax() const;
+    int getFractionDigits() const;
+
+private:
+    const QVector<qint64> timestamps;
+    const QVector<double> values;
+    const double min;
+    const double max;
+    const int fractionDigits;
+};
+
+#endif // CHART_SERIES_H
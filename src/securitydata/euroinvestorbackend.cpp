@@ -16,9 +16,13 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "euroinvestorbackend.h"
-#include "chartdatacalculator.h"
+#include "../loggingcategories.h"
+#include "backenddescriptor.h"
+#include "chartseries.h"
+#include "jsonstreamreader.h"
 
 #include "../constants.h"
+#include "../timestamputils.h"
 
 #include <QDateTime>
 #include <QDebug>
@@ -28,48 +32,85 @@
 #include <QUrl>
 #include <QUrlQuery>
 
-EuroinvestorBackend::EuroinvestorBackend(QNetworkAccessManager *manager, QObject *parent)
-    : AbstractDataBackend(manager, parent) {
-    qDebug() << "Initializing Euroinvestor Backend...";
-    this->supportedChartTypes = (ChartType::INTRADAY | ChartType::MONTH | ChartType::THREE_MONTHS | ChartType::YEAR
-                                 | ChartType::THREE_YEARS);
+namespace {
+
+constexpr BackendDescriptor EUROINVESTOR_DESCRIPTOR = {EUROINVESTOR_API_SEARCH,
+                                                       EUROINVESTOR_API_QUOTE,
+                                                       EUROINVESTOR_API_CLOSE_PRICES,
+                                                       EUROINVESTOR_API_INTRADAY_PRICES,
+                                                       AbstractDataBackend::INTRADAY | AbstractDataBackend::MONTH
+                                                           | AbstractDataBackend::THREE_MONTHS
+                                                           | AbstractDataBackend::YEAR
+                                                           | AbstractDataBackend::THREE_YEARS};
+
+// currency symbol and timestamps are converted
+constexpr FieldMapping EUROINVESTOR_QUOTE_FIELDS[] = {{"extRefId", "id"},
+                                                      {"name", "name"},
+                                                      {"currency", "currency"},
+                                                      {"price", "last"},
+                                                      {"symbol1", "symbol"},
+                                                      {"isin", "isin"},
+                                                      {"changeAbsolute", "change"},
+                                                      {"changeRelative", "changeInPercentage"},
+                                                      {"high", "high"},
+                                                      {"low", "low"},
+                                                      {"ask", "ask"},
+                                                      {"bid", "bid"},
+                                                      {"volume", "volume"},
+                                                      {"numberOfStocks", "numberOfStocks"}};
+static_assert(isValidMapping(EUROINVESTOR_QUOTE_FIELDS), "invalid quote field mapping");
+
+// fields of the nested exchange object
+constexpr FieldMapping EUROINVESTOR_EXCHANGE_FIELDS[] = {{"stockMarketName", "name"},
+                                                         // not persisted - displayed on the add stock page
+                                                         // quote result is the same as the name search
+                                                         {"genericText1", "name"}};
+static_assert(isValidMapping(EUROINVESTOR_EXCHANGE_FIELDS), "invalid exchange field mapping");
+
+} // namespace
+
+EuroinvestorBackend::EuroinvestorBackend(NetworkService *networkService, QObject *parent)
+    : AbstractDataBackend(networkService, parent) {
+    qCDebug(lcParse) << "Initializing Euroinvestor Backend...";
+    this->supportedChartTypes = EUROINVESTOR_DESCRIPTOR.supportedChartTypes;
 }
 
 EuroinvestorBackend::~EuroinvestorBackend() {
-    qDebug() << "Shutting down Euroinvestor Backend...";
+    qCDebug(lcParse) << "Shutting down Euroinvestor Backend...";
 }
 
-void EuroinvestorBackend::searchName(const QString &searchString) {
-    qDebug() << "EuroinvestorBackend::searchName";
-    QNetworkReply *reply = executeGetRequest(QUrl(EUROINVESTOR_API_SEARCH + searchString));
+void EuroinvestorBackend::searchName(const QString &searchString, const int requestId) {
+    qCDebug(lcParse) << "EuroinvestorBackend::searchName";
+    PendingReply *reply = executeGetRequest(QUrl(EUROINVESTOR_DESCRIPTOR.searchUrl + searchString), requestId);
 
     connectErrorSlot(reply);
     connect(reply, SIGNAL(finished()), this, SLOT(handleSearchNameFinished()));
 }
 
-void EuroinvestorBackend::searchQuoteForNameSearch(const QString &searchString) {
-    qDebug() << "EuroinvestorBackend::searchQuoteForNameSearch";
-    QNetworkReply *reply = executeGetRequest(QUrl(EUROINVESTOR_API_QUOTE + searchString));
+void EuroinvestorBackend::searchQuoteForNameSearch(const QString &searchString, const int requestId) {
+    qCDebug(lcParse) << "EuroinvestorBackend::searchQuoteForNameSearch";
+    PendingReply *reply = executeGetRequest(QUrl(EUROINVESTOR_DESCRIPTOR.quoteUrl + searchString), requestId);
 
     connectErrorSlot(reply);
     connect(reply, SIGNAL(finished()), this, SLOT(handleSearchQuoteForNameFinished()));
 }
 
-void EuroinvestorBackend::fetchPricesForChart(const QString &extRefId, int chartType) {
-    qDebug() << "EuroinvestorBackend::fetchClosePrices";
+void EuroinvestorBackend::fetchPricesForChart(const QString &extRefId, const int chartType, const int requestId) {
+    qCDebug(lcChart) << "EuroinvestorBackend::fetchClosePrices";
 
     if (!isChartTypeSupported(chartType)) {
-        qDebug() << "EuroinvestorBackend::fetchClosePrices - chart type " << chartType << " not supported!";
+        qCDebug(lcChart) << "EuroinvestorBackend::fetchClosePrices - chart type " << chartType << " not supported!";
         return;
     }
 
     QString startDateString = getStartDateForChart(chartType).toString("yyyy-MM-dd");
 
-    QNetworkReply *reply;
+    PendingReply *reply;
     if (chartType == ChartType::INTRADAY) {
-        reply = executeGetRequest(QUrl(QString(EUROINVESTOR_API_INTRADAY_PRICES).arg(extRefId)));
+        reply = executeGetRequest(QUrl(QString(EUROINVESTOR_DESCRIPTOR.intradayChartUrl).arg(extRefId)), requestId);
     } else {
-        reply = executeGetRequest(QUrl(QString(EUROINVESTOR_API_CLOSE_PRICES).arg(extRefId, startDateString)));
+        reply = executeGetRequest(QUrl(QString(EUROINVESTOR_DESCRIPTOR.chartUrl).arg(extRefId, startDateString)),
+                                  requestId);
     }
 
     // TODO not sure if connecting the error slot makes sense here if we have multiple charts
@@ -77,20 +118,25 @@ void EuroinvestorBackend::fetchPricesForChart(const QString &extRefId, int chart
     // connectErrorSlot(reply);
     connect(reply, SIGNAL(finished()), this, SLOT(handleFetchPricesForChartFinished()));
 
-    reply->setProperty("type", chartType);
+    reply->setProperty(NETWORK_REPLY_PROPERTY_CHART_TYPE, chartType);
+    reply->setProperty(NETWORK_REPLY_PROPERTY_EXT_REF_ID, extRefId);
 }
 
-void EuroinvestorBackend::searchQuote(const QString &searchString) {
-    qDebug() << "EuroinvestorBackend::searchQuote";
-    QNetworkReply *reply = executeGetRequest(QUrl(EUROINVESTOR_API_QUOTE + searchString));
+QList<QStringList> EuroinvestorBackend::splitQuoteBatches(const QStringList &extRefIds) {
+    // the quote batcher splits the ids by url length and merges them with the lookups of other callers
+    return QList<QStringList>() << extRefIds;
+}
 
+PendingReply *EuroinvestorBackend::executeQuoteBatchRequest(const QStringList &extRefIds,
+                                                            RequestScheduler::RequestPriority priority) {
+    PendingReply *reply = networkService->getBatched(EUROINVESTOR_DESCRIPTOR.quoteUrl, extRefIds, priority);
     connectErrorSlot(reply);
-    connect(reply, SIGNAL(finished()), this, SLOT(handleSearchQuoteFinished()));
+    return reply;
 }
 
 void EuroinvestorBackend::handleSearchNameFinished() {
-    qDebug() << "EuroinvestorBackend::handleSearchNameFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcParse) << "EuroinvestorBackend::handleSearchNameFinished";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
@@ -100,7 +146,7 @@ void EuroinvestorBackend::handleSearchNameFinished() {
     QJsonDocument jsonDocument = QJsonDocument::fromJson(searchReply);
     if (jsonDocument.isArray()) {
         QJsonArray responseArray = jsonDocument.array();
-        qDebug() << "array size : " << responseArray.size();
+        qCDebug(lcParse) << "array size : " << responseArray.size();
 
         QStringList idList;
 
@@ -112,162 +158,170 @@ void EuroinvestorBackend::handleSearchNameFinished() {
 
         QString quoteQueryIds = idList.join(",");
 
-        qDebug() << "EuroinvestorBackend::handleSearchNameFinished - quoteQueryIds : " << quoteQueryIds;
+        qCDebug(lcParse) << "EuroinvestorBackend::handleSearchNameFinished - quoteQueryIds : " << quoteQueryIds;
 
-        searchQuoteForNameSearch(quoteQueryIds);
+        // the quote lookup belongs to the same request as the name search
+        searchQuoteForNameSearch(quoteQueryIds, requestIdOf(reply));
 
     } else {
-        qDebug() << "not a json object !";
+        qCDebug(lcParse) << "not a json object !";
+        discardRequest(requestIdOf(reply));
     }
 }
 
 void EuroinvestorBackend::handleSearchQuoteForNameFinished() {
-    qDebug() << "EuroinvestorBackend::handleSearchQuoteForNameFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcParse) << "EuroinvestorBackend::handleSearchQuoteForNameFinished";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
     }
 
-    emit searchResultAvailable(processQuoteSearchResult(reply->readAll()));
+    deliverSearchResult(requestIdOf(reply), processQuoteSearchResult(reply->readAll()));
 }
 
-void EuroinvestorBackend::handleSearchQuoteFinished() {
-    qDebug() << "EuroinvestorBackend::handleSearchQuoteFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+void EuroinvestorBackend::handleFetchPricesForChartFinished() {
+    qCDebug(lcChart) << "EuroinvestorBackend::handleFetchPricesForChartFinished";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
     }
 
-    emit quoteResultAvailable(processQuoteSearchResult(reply->readAll()));
-}
-
-void EuroinvestorBackend::handleFetchPricesForChartFinished() {
-    qDebug() << "EuroinvestorBackend::handleFetchPricesForChartFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    reply->deleteLater();
-    if (reply->error() != QNetworkReply::NoError) {
+    const int chartType = reply->property(NETWORK_REPLY_PROPERTY_CHART_TYPE).toInt();
+    const int requestId = requestIdOf(reply);
+    if (chartType == ChartType::INTRADAY) {
+        // the api always returns the whole trading day - only the points after the cached ones are parsed
+        const QString extRefId = reply->property(NETWORK_REPLY_PROPERTY_EXT_REF_ID).toString();
+        const qint64 afterTimestamp = intradaySeriesCache.lastTimestamp(extRefId);
+        networkService->processInBackground(
+            reply->readAll(),
+            [this, afterTimestamp](const QByteArray &data) { return parsePriceResponse(data, afterTimestamp); },
+            this,
+            [this, requestId, extRefId](const QVariant &chartSeriesData) {
+                mergeIntradayPoints(requestId, extRefId, chartSeriesData);
+            },
+            reply->tag(),
+            [this, requestId]() { discardRequest(requestId); });
         return;
     }
 
-    QByteArray resultByteArray = reply->readAll();
-
-    // QString result = QString(resultByteArray);
-    // qDebug() << "EuroinvestorBackend::handleFetchPricesForChartFinished result " << result;
-
-    QString jsonResponseString = parsePriceResponse(resultByteArray);
-
-    if (!jsonResponseString.isNull()) {
-        emit fetchPricesForChartAvailable(jsonResponseString, reply->property("type").toInt());
-    }
+    networkService->processInBackground(
+        reply->readAll(),
+        [this](const QByteArray &data) { return parsePriceResponse(data); },
+        this,
+        [this, requestId, chartType](const QVariant &chartSeriesData) {
+            deliverChartSeries(requestId, chartSeriesData, chartType);
+        },
+        reply->tag(),
+        [this, requestId]() { discardRequest(requestId); });
 }
 
-QString EuroinvestorBackend::parsePriceResponse(QByteArray reply) {
-    QJsonDocument jsonDocument = QJsonDocument::fromJson(reply);
-    if (!jsonDocument.isArray()) {
-        qDebug() << "not a json array!";
-        return QString();
+void EuroinvestorBackend::mergeIntradayPoints(const int requestId,
+                                              const QString &extRefId,
+                                              const QVariant &chartSeriesData) {
+    if (!chartSeriesData.isValid()) {
+        discardRequest(requestId);
+        return;
     }
 
-    QJsonArray responseArray = jsonDocument.array();
-    QJsonDocument resultDocument;
-    QJsonArray resultArray;
-
-    ChartDataCalculator chartDataCalculator;
-
-    foreach (const QJsonValue &value, responseArray) {
-        QJsonObject rootObject = value.toObject();
-        QJsonObject resultObject;
-
-        QJsonValue jsonUpdatedAt = rootObject.value("timestamp");
-        //        QDateTime dateTimeUpdatedAt = QDateTime::fromString(jsonUpdatedAt.toString(), Qt::ISODate);
+    const bool cached = (intradaySeriesCache.lastTimestamp(extRefId) > 0);
+    const int appendedCount = intradaySeriesCache.merge(extRefId, chartSeriesData.value<ChartSeriesData>());
+    const ChartSeriesData series = intradaySeriesCache.series(extRefId);
+    qCDebug(lcChart) << "EuroinvestorBackend::mergeIntradayPoints - appended" << appendedCount << "of" << series.size();
 
-        QDateTime updatedAtLocalTime = convertUTCDateTimeToLocalDateTime(jsonUpdatedAt.toString());
-
-        //        qDebug() << dateTimeUpdatedAt << " - " << updatedAtLocalTime;
-
-        double closeValue = rootObject.value("close").toDouble();
-
-        chartDataCalculator.checkCloseValue(closeValue);
+    if (!cached || appendedCount == series.size()) {
+        // first fetch or new trading day
+        deliverChartSeries(requestId, QVariant::fromValue(series), ChartType::INTRADAY);
+    } else {
+        deliverChartSeriesAppended(requestId, series, appendedCount, ChartType::INTRADAY);
+    }
+}
 
-        resultObject.insert("x", updatedAtLocalTime.toMSecsSinceEpoch() / 1000);
-        resultObject.insert("y", closeValue);
+QVariant EuroinvestorBackend::parsePriceResponse(const QByteArray &reply, const qint64 afterTimestamp) {
+    JsonStreamReader reader;
+    reader.addData(reply);
+    reader.finish();
 
-        resultArray.push_back(resultObject);
+    if (reader.readNext() != JsonStreamReader::START_ARRAY) {
+        qCDebug(lcParse) << "not a json array!";
+        return QVariant();
     }
 
-    QJsonObject resultObject;
-    resultObject.insert("min", chartDataCalculator.getMinValue());
-    resultObject.insert("max", chartDataCalculator.getMaxValue());
-    resultObject.insert("fractionDigits", chartDataCalculator.getFractionDigits());
-    resultObject.insert("data", resultArray);
+    // [ { "timestamp": "...", "close": 1.23, ... }, ... ]
+    ChartSeriesData chartSeriesData;
+    if (afterTimestamp == 0) {
+        // every point is an object - the opening braces bound the points, so the arrays are allocated only once.
+        // a refresh only returns a few new points - no need to reserve the whole response
+        chartSeriesData.reserve(reply.count('{'));
+    }
+    const qint64 afterMSecsSinceEpoch = afterTimestamp * 1000;
+    qint64 mSecsSinceEpoch = 0;
+    double closeValue = 0.0;
+
+    JsonStreamReader::TokenType token;
+    while ((token = reader.readNext()) != JsonStreamReader::END_OF_DATA) {
+        if (token == JsonStreamReader::INVALID) {
+            qCWarning(lcParse) << "EuroinvestorBackend::parsePriceResponse - invalid json";
+            return QVariant();
+        }
+        if (reader.depth() == 2 && token == JsonStreamReader::STRING && reader.key(1) == QLatin1String("timestamp")) {
+            // converted right away - the string value is not kept, so the reader reuses its buffer
+            // msecs since epoch do not depend on the time zone - no conversion to local time required
+            mSecsSinceEpoch = TimestampUtils::utcTimestampToMSecs(reader.stringValue());
+        } else if (reader.depth() == 2 && token == JsonStreamReader::NUMBER && reader.key(1) == QLatin1String("close")) {
+            closeValue = reader.numberValue();
+        } else if (reader.depth() == 1 && token == JsonStreamReader::END_OBJECT) {
+            if (afterTimestamp == 0 || mSecsSinceEpoch > afterMSecsSinceEpoch) {
+                chartSeriesData.append(mSecsSinceEpoch, closeValue);
+            }
+            mSecsSinceEpoch = 0;
+            closeValue = 0.0;
+        }
+    }
 
-    resultDocument.setObject(resultObject);
+    return QVariant::fromValue(chartSeriesData);
+}
 
-    QString dataToString(resultDocument.toJson());
-    return dataToString;
+QString EuroinvestorBackend::processQuoteSearchResult(const QByteArray &searchReply) {
+    qCDebug(lcParse) << "EuroinvestorBackend::processQuoteSearchResult";
+    return QString::fromUtf8(QJsonDocument(parseQuoteBatch(searchReply)).toJson());
 }
 
-QString EuroinvestorBackend::processQuoteSearchResult(QByteArray searchReply) {
-    qDebug() << "EuroinvestorBackend::processQuoteSearchResult";
-    QJsonDocument jsonDocument = QJsonDocument::fromJson(searchReply);
+QJsonArray EuroinvestorBackend::parseQuoteBatch(const QByteArray &quoteReply) {
+    QJsonDocument jsonDocument = QJsonDocument::fromJson(quoteReply);
     if (!jsonDocument.isArray()) {
-        qDebug() << "not a json array!";
+        qCDebug(lcParse) << "not a json array!";
     }
 
     QJsonArray responseArray = jsonDocument.array();
-    QJsonDocument resultDocument;
     QJsonArray resultArray;
 
+    // the same for all quotes of the response
+    const QString lastChangeTimestamp = convertToDatabaseDateTimeFormat(QDateTime::currentDateTime());
+
+    static const auto quoteFieldMapper = objectFieldMapper(EUROINVESTOR_QUOTE_FIELDS);
+    static const auto exchangeFieldMapper = objectFieldMapper(EUROINVESTOR_EXCHANGE_FIELDS);
+
     foreach (const QJsonValue &value, responseArray) {
         QJsonObject rootObject = value.toObject();
-        QJsonObject exchangeObject = rootObject["exchange"].toObject();
 
         QJsonObject resultObject;
-        resultObject.insert("extRefId", rootObject.value("id"));
-        resultObject.insert("name", rootObject.value("name"));
-        resultObject.insert("currency", rootObject.value("currency"));
-        resultObject.insert("currencySymbol", convertCurrency(rootObject.value("currency").toString()));
-        resultObject.insert("price", rootObject.value("last"));
-        resultObject.insert("symbol1", rootObject.value("symbol"));
-        resultObject.insert("isin", rootObject.value("isin"));
-        resultObject.insert("stockMarketName", exchangeObject.value("name"));
-        resultObject.insert("changeAbsolute", rootObject.value("change"));
-        resultObject.insert("changeRelative", rootObject.value("changeInPercentage"));
-        resultObject.insert("high", rootObject.value("high"));
-        resultObject.insert("low", rootObject.value("low"));
-        resultObject.insert("ask", rootObject.value("ask"));
-        resultObject.insert("bid", rootObject.value("bid"));
-        resultObject.insert("volume", rootObject.value("volume"));
-        resultObject.insert("numberOfStocks", rootObject.value("numberOfStocks"));
-
-        QJsonValue jsonUpdatedAt = rootObject.value("updatedAt");
-        QDateTime updatedAtLocalTime = convertUTCDateTimeToLocalDateTime(jsonUpdatedAt.toString());
-        resultObject.insert("quoteTimestamp", convertToDatabaseDateTimeFormat(updatedAtLocalTime));
-
-        resultObject.insert("lastChangeTimestamp", convertToDatabaseDateTimeFormat(QDateTime::currentDateTime()));
-
-        // not persisted - displayed on the add stock page
-        // quote result is the same as the name search
-        resultObject.insert("genericText1", exchangeObject.value("name")); // stockMarketName
+        quoteFieldMapper.map(rootObject, resultObject);
+        exchangeFieldMapper.map(rootObject.value(QStringLiteral("exchange")).toObject(), resultObject);
+        resultObject.insert(QStringLiteral("currencySymbol"),
+                            convertCurrency(rootObject.value(QStringLiteral("currency")).toString()));
 
-        resultArray.push_back(resultObject);
-    }
+        QJsonValue jsonUpdatedAt = rootObject.value(QStringLiteral("updatedAt"));
+        QDateTime updatedAtLocalTime = TimestampUtils::convertUtcToLocalDateTime(jsonUpdatedAt.toString());
+        resultObject.insert(QStringLiteral("quoteTimestamp"), convertToDatabaseDateTimeFormat(updatedAtLocalTime));
 
-    resultDocument.setArray(resultArray);
-    QString dataToString(resultDocument.toJson());
+        resultObject.insert(QStringLiteral("lastChangeTimestamp"), lastChangeTimestamp);
 
-    return dataToString;
-}
-
-QDateTime EuroinvestorBackend::convertUTCDateTimeToLocalDateTime(const QString &utcDateTimeString) {
-    QDateTime utcDateTime = QDateTime::fromString(utcDateTimeString, Qt::ISODate);
-    QDateTime localDateTime = QDateTime(utcDateTime.date(), utcDateTime.time(), Qt::UTC).toLocalTime();
-
-    // qDebug() << " converted date from " << utcDateTimeString << " to " << localDateTime;
+        resultArray.push_back(resultObject);
+    }
 
-    return localDateTime;
+    return resultArray;
 }
 
 QString EuroinvestorBackend::convertCurrency(const QString &currencyString) {
@@ -19,38 +19,44 @@
 #define EUROINVESTORBACKEND_H
 
 #include "abstractdatabackend.h"
+#include "intradayseriescache.h"
 
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
 
 class EuroinvestorBackend : public AbstractDataBackend {
     Q_OBJECT
 public:
-    explicit EuroinvestorBackend(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    explicit EuroinvestorBackend(NetworkService *networkService, QObject *parent = nullptr);
     ~EuroinvestorBackend() override;
-    Q_INVOKABLE void searchName(const QString &searchString) override;
-    Q_INVOKABLE void searchQuote(const QString &searchString) override;
-    Q_INVOKABLE void fetchPricesForChart(const QString &extRefId, int chartType) override;
+    void searchName(const QString &searchString, const int requestId) override;
+    void fetchPricesForChart(const QString &extRefId, const int chartType, const int requestId) override;
+
+    QList<QStringList> splitQuoteBatches(const QStringList &extRefIds) override;
+    QJsonArray parseQuoteBatch(const QByteArray &quoteReply) override;
 
 signals:
 
 protected:
     QString convertCurrency(const QString &currencyString) override;
+    PendingReply *executeQuoteBatchRequest(const QStringList &extRefIds,
+                                           RequestScheduler::RequestPriority priority) override;
 
 public slots:
 
 private:
+    IntradaySeriesCache intradaySeriesCache;
+
     // is triggered after name search because the first json request does not contain all information we need
-    void searchQuoteForNameSearch(const QString &searchString);
-    QString processQuoteSearchResult(QByteArray searchReply);
-    QString parsePriceResponse(QByteArray priceReply);
-    QDateTime convertUTCDateTimeToLocalDateTime(const QString &utcDateTimeString);
+    void searchQuoteForNameSearch(const QString &searchString, const int requestId);
+    QString processQuoteSearchResult(const QByteArray &searchReply);
+    // points up to afterTimestamp (seconds since epoch) are skipped
+    QVariant parsePriceResponse(const QByteArray &priceReply, qint64 afterTimestamp = 0);
+    void mergeIntradayPoints(const int requestId, const QString &extRefId, const QVariant &chartSeriesData);
 
 private slots:
     void handleSearchNameFinished();
     void handleSearchQuoteForNameFinished();
-    void handleSearchQuoteFinished();
     void handleFetchPricesForChartFinished();
 };
 
@@ -16,8 +16,11 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "ingdibabackend.h"
+#include "../loggingcategories.h"
 #include "../ingdibautils.h"
-#include "chartdatacalculator.h"
+#include "backenddescriptor.h"
+#include "chartseries.h"
+#include "jsonstreamreader.h"
 
 #include "../constants.h"
 
@@ -29,117 +32,208 @@
 #include <QJsonObject>
 #include <QRegularExpression>
 #include <QTimeZone>
+#include <QTimer>
 #include <QUrl>
 #include <QUrlQuery>
 #include <QUuid>
 #include <QVariantMap>
 
-#define LOG(x) qDebug() << "IngDibaBackend::" << x
-
-IngDibaBackend::IngDibaBackend(QNetworkAccessManager *manager, QObject *parent)
-    : AbstractDataBackend(manager, parent) {
-    qDebug() << "Initializing Ing Diba Backend...";
-    this->supportedChartTypes = (ChartType::INTRADAY | ChartType::WEEK | ChartType::MONTH | ChartType::YEAR
-                                 | ChartType::THREE_YEARS | ChartType::MAXIMUM);
-    this->chartTypeToStringMap[ChartType::INTRADAY] = "Intraday";
-    this->chartTypeToStringMap[ChartType::WEEK] = "OneWeek";
-    this->chartTypeToStringMap[ChartType::MONTH] = "OneMonth";
-    this->chartTypeToStringMap[ChartType::YEAR] = "OneYear";
-    this->chartTypeToStringMap[ChartType::THREE_YEARS] = "ThreeYears";
-    this->chartTypeToStringMap[ChartType::MAXIMUM] = "Maximum";
+namespace {
+
+constexpr BackendDescriptor ING_DIBA_DESCRIPTOR = {ING_DIBA_API_SEARCH,
+                                                   ING_DIBA_API_QUOTE,
+                                                   ING_DIBA_API_CHART_PRICES,
+                                                   nullptr,
+                                                   AbstractDataBackend::INTRADAY | AbstractDataBackend::WEEK
+                                                       | AbstractDataBackend::MONTH | AbstractDataBackend::YEAR
+                                                       | AbstractDataBackend::THREE_YEARS
+                                                       | AbstractDataBackend::MAXIMUM};
+
+// time range parameter of the chart api
+struct ChartTimeRange
+{
+    int chartType;
+    const char *timeRange;
+};
+
+constexpr ChartTimeRange ING_DIBA_CHART_TIME_RANGES[] = {{AbstractDataBackend::INTRADAY, "Intraday"},
+                                                         {AbstractDataBackend::WEEK, "OneWeek"},
+                                                         {AbstractDataBackend::MONTH, "OneMonth"},
+                                                         {AbstractDataBackend::YEAR, "OneYear"},
+                                                         {AbstractDataBackend::THREE_YEARS, "ThreeYears"},
+                                                         {AbstractDataBackend::MAXIMUM, "Maximum"}};
+
+static_assert(coversChartTypes(ING_DIBA_CHART_TIME_RANGES, ING_DIBA_DESCRIPTOR.supportedChartTypes),
+              "every supported chart type needs a time range");
+
+constexpr FieldMapping ING_DIBA_SEARCH_FIELDS[] = {{"extRefId", "isin"},
+                                                   {"symbol1", "wkn"},
+                                                   {"name", "text"},
+                                                   {"isin", "isin"},
+                                                   {"price", "price_html"},
+                                                   // not persisted - displayed on the add stock page
+                                                   {"genericText1", "price_html"}};
+static_assert(isValidMapping(ING_DIBA_SEARCH_FIELDS), "invalid search field mapping");
+
+// isin, currency symbol and timestamps are converted
+constexpr FieldMapping ING_DIBA_QUOTE_FIELDS[] = {{"name", "name"},
+                                                  {"symbol1", "wkn"},
+                                                  {"currency", "currency"},
+                                                  {"price", "price"},
+                                                  {"ask", "ask"},
+                                                  {"bid", "bid"},
+                                                  {"changeAbsolute", "changeAbsolute"},
+                                                  {"changeRelative", "changePercent"},
+                                                  {"stockMarketName", "stockMarket"}};
+static_assert(isValidMapping(ING_DIBA_QUOTE_FIELDS), "invalid quote field mapping");
+
+} // namespace
+
+IngDibaBackend::IngDibaBackend(NetworkService *networkService, QObject *parent)
+    : AbstractDataBackend(networkService, parent) {
+    qCDebug(lcParse) << "Initializing Ing Diba Backend...";
+    this->supportedChartTypes = ING_DIBA_DESCRIPTOR.supportedChartTypes;
+    for (const ChartTimeRange &chartTimeRange : ING_DIBA_CHART_TIME_RANGES) {
+        this->chartTypeToStringMap[chartTimeRange.chartType] = QString::fromLatin1(chartTimeRange.timeRange);
+    }
 }
 
 IngDibaBackend::~IngDibaBackend() {
-    qDebug() << "Shutting down Ing Diba Backend...";
+    qCDebug(lcParse) << "Shutting down Ing Diba Backend...";
 }
 
-void IngDibaBackend::searchName(const QString &searchString) {
-    qDebug() << "IngDibaBackend::searchName";
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(ING_DIBA_API_SEARCH).arg(searchString)));
+void IngDibaBackend::searchName(const QString &searchString, const int requestId) {
+    qCDebug(lcParse) << "IngDibaBackend::searchName";
+    PendingReply *reply = executeGetRequest(QUrl(QString(ING_DIBA_DESCRIPTOR.searchUrl).arg(searchString)), requestId);
 
     connectErrorSlot(reply);
     connect(reply, SIGNAL(finished()), this, SLOT(handleSearchNameFinished()));
 }
 
-void IngDibaBackend::searchQuoteForNameSearch(const QString &searchString) {
+void IngDibaBackend::searchQuoteForNameSearch(const QString &searchString, const int requestId) {
     // TODO check if needed
-    qDebug() << "IngDibaBackend::searchQuoteForNameSearch";
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(ING_DIBA_API_QUOTE).arg(searchString)));
+    qCDebug(lcParse) << "IngDibaBackend::searchQuoteForNameSearch";
+    PendingReply *reply = executeGetRequest(QUrl(QString(ING_DIBA_DESCRIPTOR.quoteUrl).arg(searchString)), requestId);
 
     connectErrorSlot(reply);
     connect(reply, SIGNAL(finished()), this, SLOT(handleSearchQuoteForNameFinished()));
 }
 
-void IngDibaBackend::fetchPricesForChart(const QString &extRefId, const int chartType) {
-    qDebug() << "IngDibaBackend::fetchPricesForChart";
+void IngDibaBackend::fetchPricesForChart(const QString &extRefId, const int chartType, const int requestId) {
+    qCDebug(lcChart) << "IngDibaBackend::fetchPricesForChart";
 
     if (!isChartTypeSupported(chartType)) {
-        qDebug() << "IngDibaBackend::fetchClosePrices - chart type " << chartType << " not supported!";
+        qCDebug(lcChart) << "IngDibaBackend::fetchClosePrices - chart type " << chartType << " not supported!";
         return;
     }
 
-    QNetworkReply *reply;
+    if (hasChartMetadata(extRefId)) {
+        fetchChartPrices(extRefId, chartType, requestId);
+        return;
+    }
 
-    reply = executeGetRequest(QUrl(QString(ING_DIBA_API_PREQUOTE_DATA).arg(extRefId)));
+    PendingReply *reply = executeGetRequest(QUrl(QString(ING_DIBA_API_PREQUOTE_DATA).arg(extRefId)), requestId);
     reply->setProperty(NETWORK_REPLY_PROPERTY_CHART_TYPE, chartType);
     reply->setProperty(NETWORK_REPLY_PROPERTY_EXT_REF_ID, extRefId);
     connectErrorSlot(reply);
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
+    connect(reply, &PendingReply::finished, [this, reply]() {
         reply->deleteLater();
-
-        qDebug() << sender();
-        qDebug() << "type :" << reply->property(NETWORK_REPLY_PROPERTY_CHART_TYPE);
-        qDebug() << "extRefId :" << reply->property(NETWORK_REPLY_PROPERTY_EXT_REF_ID);
-
         processPreQuoteData(reply);
     });
 }
 
-void IngDibaBackend::processPreQuoteData(QNetworkReply *preChartReply) {
-    qDebug() << "IngDibaBackend::processPreQuoteData";
-    const QJsonDocument jsonDocument = QJsonDocument::fromJson(preChartReply->readAll());
+void IngDibaBackend::processPreQuoteData(PendingReply *preChartReply) {
+    qCDebug(lcParse) << "IngDibaBackend::processPreQuoteData";
+    if (preChartReply->error() != QNetworkReply::NoError) {
+        return;
+    }
+
     const QString extRefId = preChartReply->property(NETWORK_REPLY_PROPERTY_EXT_REF_ID).toString();
     const int chartType = preChartReply->property(NETWORK_REPLY_PROPERTY_CHART_TYPE).toInt();
 
+    storeChartMetadata(extRefId, preChartReply->readAll());
+    // the chart request belongs to the same scope as the pre quote request
+    networkService->beginRequestScope(preChartReply->tag());
+    fetchChartPrices(extRefId, chartType, requestIdOf(preChartReply));
+    networkService->endRequestScope();
+}
+
+void IngDibaBackend::storeChartMetadata(const QString &extRefId, const QByteArray &preQuoteReply) {
+    const QJsonDocument jsonDocument = QJsonDocument::fromJson(preQuoteReply);
     if (!jsonDocument.isObject()) {
-        qDebug() << "not a json object!";
+        qCDebug(lcParse) << "not a json object!";
+        return;
     }
 
-    const QJsonObject responseObject = jsonDocument.object();
-    const QString valor = responseObject["valor"].toString();
-    const QJsonArray chartPeriods = responseObject["chartPeriods"].toArray();
-    const QString chartTypeString = this->chartTypeToStringMap[chartType];
+    ChartMetadata chartMetadata;
+    chartMetadata.fetchTime = QDateTime::currentDateTimeUtc();
+    foreach (const QJsonValue &chartPeriod, jsonDocument.object()["chartPeriods"].toArray()) {
+        if (chartPeriod.isString()) {
+            chartMetadata.chartPeriods.append(chartPeriod.toString());
+        }
+    }
 
-    qDebug() << "valor : " << valor;
-    qDebug() << "chartTypeString : " << chartTypeString;
-    qDebug() << "chartPeriods : " << chartPeriods;
+    qCDebug(lcChart) << "IngDibaBackend::storeChartMetadata - " << extRefId << " chart periods : " << chartMetadata.chartPeriods;
+    chartMetadataCache.insert(extRefId, chartMetadata);
+}
 
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(ING_DIBA_API_CHART_PRICES).arg(extRefId, chartTypeString)));
-    reply->setProperty("type", chartType);
-    connectErrorSlot(reply);
-    connect(reply, &QNetworkReply::finished, this, &IngDibaBackend::handleFetchPricesForChartFinished);
+bool IngDibaBackend::hasChartMetadata(const QString &extRefId) const {
+    return chartMetadataCache.contains(extRefId)
+           && chartMetadataCache.value(extRefId).fetchTime.secsTo(QDateTime::currentDateTimeUtc())
+                  < ING_DIBA_CHART_METADATA_TTL;
 }
 
-void IngDibaBackend::searchQuote(const QString &searchString) {
-    // TODO check if needed
-    qDebug() << "IngDibaBackend::searchQuote";
+bool IngDibaBackend::isChartPeriodAvailable(const QString &extRefId, int chartType) const {
+    const QStringList chartPeriods = chartMetadataCache.value(extRefId).chartPeriods;
+    // no information about the chart periods - let the api decide
+    if (chartPeriods.isEmpty()) {
+        return true;
+    }
+    return chartPeriods.contains(chartTypeToStringMap.value(chartType));
+}
 
-    QStringList ibanList = searchString.split(",");
-    this->numberOfRequestedIbans = ibanList.size();
-    searchQuoteResults.clear();
+void IngDibaBackend::fetchChartPrices(const QString &extRefId, int chartType, const int requestId) {
+    if (!isChartPeriodAvailable(extRefId, chartType)) {
+        qCDebug(lcChart) << "IngDibaBackend::fetchChartPrices - chart type " << chartType << " not available for " << extRefId;
+        // an empty series tells the chart page that there is nothing to load - after the caller got its id
+        QTimer::singleShot(0, this, [this, requestId, chartType]() {
+            deliverChartSeries(requestId, QVariant::fromValue(ChartSeriesData()), chartType);
+        });
+        return;
+    }
 
-    foreach (const QString &iban, ibanList) {
-        qDebug() << "looking up " << iban;
-        QNetworkReply *reply = executeGetRequest(QUrl(QString(ING_DIBA_API_QUOTE).arg(iban)));
+    const QString chartTypeString = this->chartTypeToStringMap[chartType];
+    PendingReply *reply = executeGetRequest(
+        QUrl(QString(ING_DIBA_DESCRIPTOR.chartUrl).arg(extRefId, chartTypeString)), requestId);
+    reply->setProperty("type", chartType);
+    connectErrorSlot(reply);
+    connect(reply, &PendingReply::finished, this, &IngDibaBackend::handleFetchPricesForChartFinished);
+}
 
-        connectErrorSlot(reply);
-        connect(reply, SIGNAL(finished()), this, SLOT(handleSearchQuoteFinished()));
+QList<QStringList> IngDibaBackend::splitQuoteBatches(const QStringList &extRefIds) {
+    // the api has no batch lookup - one request per isin
+    QList<QStringList> batches;
+    foreach (const QString &extRefId, extRefIds) {
+        batches.append(QStringList(extRefId));
     }
+    return batches;
+}
+
+PendingReply *IngDibaBackend::executeQuoteBatchRequest(const QStringList &extRefIds,
+                                                       RequestScheduler::RequestPriority priority) {
+    PendingReply *reply
+        = executeGetRequest(QUrl(QString(ING_DIBA_DESCRIPTOR.quoteUrl).arg(extRefIds.first())), 0, priority);
+    connectErrorSlot(reply);
+    return reply;
+}
+
+QJsonArray IngDibaBackend::parseQuoteBatch(const QByteArray &quoteReply) {
+    return QJsonArray() << processQuoteResultSingle(quoteReply);
 }
 
 void IngDibaBackend::handleSearchNameFinished() {
-    qDebug() << "IngDibaBackend::handleSearchNameFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcParse) << "IngDibaBackend::handleSearchNameFinished";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
@@ -148,103 +242,101 @@ void IngDibaBackend::handleSearchNameFinished() {
     QByteArray searchReply = reply->readAll();
     QJsonDocument jsonDocument = QJsonDocument::fromJson(searchReply);
     if (jsonDocument.isObject()) {
-        emit searchResultAvailable(processSearchResult(searchReply));
+        deliverSearchResult(requestIdOf(reply), processSearchResult(searchReply));
     } else {
-        qDebug() << "not a json object !";
+        qCDebug(lcParse) << "not a json object !";
+        discardRequest(requestIdOf(reply));
     }
 }
 
 void IngDibaBackend::handleSearchQuoteForNameFinished() {
-    qDebug() << "IngDibaBackend::handleSearchQuoteForNameFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcParse) << "IngDibaBackend::handleSearchQuoteForNameFinished";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
     }
 
-    emit searchResultAvailable(processSearchResult(reply->readAll()));
-}
-
-void IngDibaBackend::handleSearchQuoteFinished() {
-    qDebug() << "IngDibaBackend::handleSearchQuoteForNameFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    reply->deleteLater();
-    if (reply->error() != QNetworkReply::NoError) {
-        return;
-    }
-
-    QJsonObject result = processQuoteResultSingle(reply->readAll());
-    searchQuoteResults.append(result);
-
-    if (searchQuoteResults.size() == this->numberOfRequestedIbans) {
-        QJsonDocument resultDocument;
-        QJsonArray resultArray;
-
-        foreach (const QJsonObject &quoteResultObject, searchQuoteResults) {
-            resultArray.push_back(quoteResultObject);
-        }
-
-        resultDocument.setArray(resultArray);
-        QString dataToString(resultDocument.toJson());
-
-        emit quoteResultAvailable(dataToString);
-    }
+    deliverSearchResult(requestIdOf(reply), processSearchResult(reply->readAll()));
 }
 
 void IngDibaBackend::handleFetchPricesForChartFinished() {
-    qDebug() << "IngDibaBackend::handleFetchPricesForChartFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcChart) << "IngDibaBackend::handleFetchPricesForChartFinished";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
     }
 
-    QByteArray resultByteArray = reply->readAll();
-
-    // QString result = QString(resultByteArray);
-    // qDebug() << "IngDibaBackend::handleFetchPricesForChartFinished result " << result;
-
-    QString jsonResponseString = parsePriceResponse(resultByteArray);
-
-    if (!jsonResponseString.isNull()) {
-        emit fetchPricesForChartAvailable(jsonResponseString, reply->property("type").toInt());
-    }
+    // large charts (e.g. maximum) take a while to parse - keep the gui thread responsive
+    const int chartType = reply->property("type").toInt();
+    const int requestId = requestIdOf(reply);
+    networkService->processInBackground(
+        reply->readAll(),
+        [this](const QByteArray &data) { return parsePriceResponse(data); },
+        this,
+        [this, requestId, chartType](const QVariant &chartSeriesData) {
+            deliverChartSeries(requestId, chartSeriesData, chartType);
+        },
+        reply->tag(),
+        [this, requestId]() { discardRequest(requestId); });
 }
 
-QString IngDibaBackend::parsePriceResponse(QByteArray reply) {
-    QJsonDocument jsonDocument = QJsonDocument::fromJson(reply);
-    if (!jsonDocument.isObject()) {
-        qDebug() << "not a json object!";
-        return QString();
+QVariant IngDibaBackend::parsePriceResponse(const QByteArray &reply) {
+    JsonStreamReader reader;
+    reader.addData(reply);
+    reader.finish();
+
+    if (reader.readNext() != JsonStreamReader::START_OBJECT) {
+        qCDebug(lcParse) << "not a json object!";
+        return QVariant();
     }
 
-    QJsonObject responseObject = jsonDocument.object();
+    // { "instruments": [ { "data": [ [ msecsSinceEpoch, close ], ... ] } ] }
     // response only contains one element in the intruments array
-    QJsonObject firstInstrumentsObject = responseObject["instruments"].toArray().at(0).toObject();
-    QJsonArray chartDataArray = firstInstrumentsObject["data"].toArray();
-
-    QJsonArray resultArray;
-    ChartDataCalculator chartDataCalculator;
-
-    foreach (const QJsonValue &value, chartDataArray) {
-        QJsonArray dataArray = value.toArray();
-        QVariant mSecsSinceEpochVariant = dataArray.at(0).toVariant();
-        auto mSecsSinceEpoch = static_cast<qint64>(mSecsSinceEpochVariant.toDouble());
-
-        double closeValue = dataArray.at(1).toDouble();
-        chartDataCalculator.checkCloseValue(closeValue);
-
-        resultArray.push_back(createChartDataPoint(mSecsSinceEpoch, closeValue));
+    ChartSeriesData chartSeriesData;
+    // every point is an array - the opening brackets bound the points, so the arrays are allocated only once
+    chartSeriesData.reserve(reply.count('['));
+    qint64 mSecsSinceEpoch = 0;
+    double closeValue = 0.0;
+    bool hasCloseValue = false;
+
+    JsonStreamReader::TokenType token;
+    while ((token = reader.readNext()) != JsonStreamReader::END_OF_DATA) {
+        if (token == JsonStreamReader::INVALID) {
+            qCWarning(lcParse) << "IngDibaBackend::parsePriceResponse - invalid json";
+            return QVariant();
+        }
+        if (reader.key(0) != QLatin1String("instruments") || reader.index(1) != 0
+            || reader.key(2) != QLatin1String("data")) {
+            continue;
+        }
+        if (reader.depth() == 5 && token == JsonStreamReader::NUMBER) {
+            if (reader.index(4) == 0) {
+                mSecsSinceEpoch = static_cast<qint64>(reader.numberValue());
+            } else if (reader.index(4) == 1) {
+                closeValue = reader.numberValue();
+                hasCloseValue = true;
+            }
+        } else if (reader.depth() == 4 && token == JsonStreamReader::END_ARRAY) {
+            // points without a close value (null) are skipped
+            if (hasCloseValue) {
+                chartSeriesData.append(mSecsSinceEpoch, closeValue);
+            }
+            mSecsSinceEpoch = 0;
+            closeValue = 0.0;
+            hasCloseValue = false;
+        }
     }
 
-    return createChartResponseString(resultArray, chartDataCalculator);
+    return QVariant::fromValue(chartSeriesData);
 }
 
-QString IngDibaBackend::processSearchResult(QByteArray searchReply) {
-    qDebug() << "IngDibaBackend::processSearchResult";
+QString IngDibaBackend::processSearchResult(const QByteArray &searchReply) {
+    qCDebug(lcParse) << "IngDibaBackend::processSearchResult";
     QJsonDocument jsonDocument = QJsonDocument::fromJson(searchReply);
     if (!jsonDocument.isObject()) {
-        qDebug() << "not a json object!";
+        qCDebug(lcParse) << "not a json object!";
     }
 
     // https://api.wertpapiere.ing.de/suche-autocomplete/autocomplete?query=de
@@ -260,30 +352,23 @@ QString IngDibaBackend::processSearchResult(QByteArray searchReply) {
     QJsonArray suggestionsWp = findFirstValueFromJsonArray(suggestionGroupsDirectHit, "group", "wp")["suggestions"]
                                    .toArray();
 
-    qDebug() << "direct hit: " << suggestionGroupsDirectHit;
-
     //QJsonArray dataArray = securitiesObject["data"].toArray();
 
     QJsonDocument resultDocument;
     QJsonArray resultArray;
 
+    static const auto searchFieldMapper = objectFieldMapper(ING_DIBA_SEARCH_FIELDS);
+
     foreach (const QJsonValue &value, suggestionsWp) {
         QJsonObject suggestion = value.toObject();
-        qDebug() << " sugg : " << suggestion["score"];
 
         QString category = suggestion["category"].toString();
         if (isValidSecurityCategory(category)) {
             // id is not mapped so far - is it used ??
             QJsonObject resultObject;
-            resultObject.insert("extRefId", suggestion["isin"]);
-            resultObject.insert("symbol1", suggestion["wkn"]);
-            resultObject.insert("name", suggestion["text"]);
-            resultObject.insert("isin", suggestion["isin"]);
+            searchFieldMapper.map(suggestion, resultObject);
             resultObject.insert("stockMarketName", "-");
             resultObject.insert("currency", QJsonValue(""));
-            resultObject.insert("price", suggestion["price_html"]);
-            // not persisted - displayed on the add stock page
-            resultObject.insert("genericText1", suggestion["price_html"]);
 
             resultArray.push_back(resultObject);
         }
@@ -295,61 +380,59 @@ QString IngDibaBackend::processSearchResult(QByteArray searchReply) {
     return dataToString;
 }
 
-bool IngDibaBackend::isValidSecurityCategory(QString category) {
+bool IngDibaBackend::isValidSecurityCategory(const QString &category) {
     return (category.compare(QString("Fonds"), Qt::CaseInsensitive) == 0
             || category.compare(QString("Aktien"), Qt::CaseInsensitive) == 0
             || category.compare(QString("ETFs"), Qt::CaseInsensitive) == 0);
 }
 
-QJsonObject IngDibaBackend::findFirstValueFromJsonArray(QJsonArray arr, QString key, QString value) {
-    for (const auto obj : arr) {
-        if (obj.toObject().value(key) == value) {
-            return obj.toObject();
+QJsonObject IngDibaBackend::findFirstValueFromJsonArray(const QJsonArray &arr, const QString &key, const QString &value) {
+    for (const QJsonValue &jsonValue : arr) {
+        const QJsonObject object = jsonValue.toObject();
+        if (object.value(key) == value) {
+            return object;
         }
     }
     return QJsonObject();
 }
 
-QJsonObject IngDibaBackend::processQuoteResultSingle(QByteArray searchQuoteReply) {
-    qDebug() << "IngDibaBackend::processQuoteResultSingle";
+QJsonObject IngDibaBackend::processQuoteResultSingle(const QByteArray &searchQuoteReply) {
+    qCDebug(lcParse) << "IngDibaBackend::processQuoteResultSingle";
     QJsonDocument jsonDocument = QJsonDocument::fromJson(searchQuoteReply);
     if (!jsonDocument.isObject()) {
-        qDebug() << "not a json object!";
+        qCDebug(lcParse) << "not a json object!";
     }
 
     QJsonObject responseObject = jsonDocument.object();
 
     // for US stocks the isin is not populated, but the internationalIsin - in this
     // case use the internationalIsin
-    bool useIsin = (!responseObject.value("isin").toString().isEmpty());
-    QJsonValue isin = (useIsin ? responseObject.value("isin") : responseObject.value("internalIsin"));
+    QJsonValue isin = responseObject.value(QStringLiteral("isin"));
+    if (isin.toString().isEmpty()) {
+        isin = responseObject.value(QStringLiteral("internalIsin"));
+    }
+
+    static const auto quoteFieldMapper = objectFieldMapper(ING_DIBA_QUOTE_FIELDS);
 
     QJsonObject resultObject;
-    resultObject.insert("name", responseObject.value("name"));
-    resultObject.insert("isin", isin);
-    resultObject.insert("extRefId", isin);
-    resultObject.insert("symbol1", responseObject.value("wkn"));
-    resultObject.insert("currency", responseObject.value("currency"));
-    resultObject.insert("currencySymbol", convertCurrency(responseObject.value("currency").toString()));
-    resultObject.insert("price", responseObject.value("price"));
-    resultObject.insert("ask", responseObject.value("ask"));
-    resultObject.insert("bid", responseObject.value("bid"));
-    resultObject.insert("changeAbsolute", responseObject.value("changeAbsolute"));
-    resultObject.insert("changeRelative", responseObject.value("changePercent"));
-    resultObject.insert("stockMarketName", responseObject.value("stockMarket"));
+    quoteFieldMapper.map(responseObject, resultObject);
+    resultObject.insert(QStringLiteral("isin"), isin);
+    resultObject.insert(QStringLiteral("extRefId"), isin);
+    resultObject.insert(QStringLiteral("currencySymbol"),
+                        convertCurrency(responseObject.value(QStringLiteral("currency")).toString()));
 
     // values we do not get
-    resultObject.insert("volume", QJsonValue(0));
-    resultObject.insert("high", QJsonValue(0));
-    resultObject.insert("low", QJsonValue(0));
-    resultObject.insert("numberOfStocks", QJsonValue(0));
+    resultObject.insert(QStringLiteral("volume"), QJsonValue(0));
+    resultObject.insert(QStringLiteral("high"), QJsonValue(0));
+    resultObject.insert(QStringLiteral("low"), QJsonValue(0));
+    resultObject.insert(QStringLiteral("numberOfStocks"), QJsonValue(0));
 
-    QJsonValue jsonPriceChangeDate = responseObject.value("priceChangeDate");
-    QDateTime updatedAtLocalTime = IngDibaUtils::convertTimestampToLocalTimestamp(jsonPriceChangeDate.toString(),
-                                                                                  QTimeZone::systemTimeZone());
-    resultObject.insert("quoteTimestamp", convertToDatabaseDateTimeFormat(updatedAtLocalTime));
+    QJsonValue jsonPriceChangeDate = responseObject.value(QStringLiteral("priceChangeDate"));
+    QDateTime updatedAtLocalTime = IngDibaUtils::convertTimestampToLocalTimestamp(jsonPriceChangeDate.toString());
+    resultObject.insert(QStringLiteral("quoteTimestamp"), convertToDatabaseDateTimeFormat(updatedAtLocalTime));
 
-    resultObject.insert("lastChangeTimestamp", convertToDatabaseDateTimeFormat(QDateTime::currentDateTime()));
+    resultObject.insert(QStringLiteral("lastChangeTimestamp"),
+                        convertToDatabaseDateTimeFormat(QDateTime::currentDateTime()));
 
     return resultObject;
 }
@@ -368,12 +451,6 @@ QJsonObject IngDibaBackend::processQuoteResultSingle(QByteArray searchQuoteReply
 //    return localDateTime;
 //}
 
-QString IngDibaBackend::processQuoteResult(QByteArray searchReply) {
-    qDebug() << "IngDibaBackend::processQuoteResult";
-    // TODO remove - dead
-    return QString("");
-}
-
 QString IngDibaBackend::convertCurrency(const QString &currencyString) {
     if (QString("EUR").compare(currencyString, Qt::CaseInsensitive) == 0) {
         return QString("\u20AC");
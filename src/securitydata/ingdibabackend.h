@@ -20,49 +20,67 @@
 
 #include "abstractdatabackend.h"
 
-#include <QNetworkAccessManager>
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <QNetworkReply>
 #include <QObject>
 
+// chart periods of an instrument are kept for one day
+const int ING_DIBA_CHART_METADATA_TTL = 24 * 60 * 60;
+
 class IngDibaBackend : public AbstractDataBackend {
     Q_OBJECT
 public:
-    explicit IngDibaBackend(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    explicit IngDibaBackend(NetworkService *networkService, QObject *parent = nullptr);
     ~IngDibaBackend() override;
-    Q_INVOKABLE void searchName(const QString &searchString) override;
-    Q_INVOKABLE void searchQuote(const QString &searchString) override;
-    Q_INVOKABLE void fetchPricesForChart(const QString &extRefId, int chartType) override;
+    void searchName(const QString &searchString, const int requestId) override;
+    void fetchPricesForChart(const QString &extRefId, const int chartType, const int requestId) override;
+
+    QList<QStringList> splitQuoteBatches(const QStringList &extRefIds) override;
+    QJsonArray parseQuoteBatch(const QByteArray &quoteReply) override;
 
 signals:
 
 protected:
     QString convertCurrency(const QString &currencyString) override;
+    PendingReply *executeQuoteBatchRequest(const QStringList &extRefIds,
+                                           RequestScheduler::RequestPriority priority) override;
 
 public slots:
 
 private:
-    int numberOfRequestedIbans = 0;
-    QList<QJsonObject> searchQuoteResults;
     QMap<int, QString> chartTypeToStringMap;
 
-    QJsonObject processQuoteResultSingle(QByteArray searchQuoteReply);
-    QJsonObject findFirstValueFromJsonArray(QJsonArray arr, QString key, QString value);
-    bool isValidSecurityCategory(QString category);
+    // chart metadata of an instrument - the chart periods do not change, so the pre quote request is only needed once
+    struct ChartMetadata
+    {
+        QStringList chartPeriods;
+        QDateTime fetchTime;
+    };
+    QHash<QString, ChartMetadata> chartMetadataCache;
+
+    QJsonObject processQuoteResultSingle(const QByteArray &searchQuoteReply);
+    QJsonObject findFirstValueFromJsonArray(const QJsonArray &arr, const QString &key, const QString &value);
+    bool isValidSecurityCategory(const QString &category);
 
     // is triggered after name search because the first json request does not contain all information we need
-    void searchQuoteForNameSearch(const QString &searchString);
-    QString processSearchResult(QByteArray searchReply);
-    QString processQuoteResult(QByteArray searchReply);
-    QString parsePriceResponse(QByteArray priceReply);
+    void searchQuoteForNameSearch(const QString &searchString, const int requestId);
+    QString processSearchResult(const QByteArray &searchReply);
+    QVariant parsePriceResponse(const QByteArray &priceReply);
 
     // QDateTime convertTimestampToLocalTimestamp(const QString &utcDateTimeString, QTimeZone timeZone);
 
-    void processPreQuoteData(QNetworkReply *preChartReply);
+    void processPreQuoteData(PendingReply *preChartReply);
+    void storeChartMetadata(const QString &extRefId, const QByteArray &preQuoteReply);
+    bool hasChartMetadata(const QString &extRefId) const;
+    bool isChartPeriodAvailable(const QString &extRefId, int chartType) const;
+    void fetchChartPrices(const QString &extRefId, int chartType, const int requestId);
 
 private slots:
     void handleSearchNameFinished();
     void handleSearchQuoteForNameFinished();
-    void handleSearchQuoteFinished();
     void handleFetchPricesForChartFinished();
 
 #ifdef UNIT_TEST
@@ -0,0 +1,66 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "intradayseriescache.h"
+
+#include <QDateTime>
+
+namespace {
+
+// the trading days of the exchanges do not span midnight utc
+QDate tradingDay(qint64 secsSinceEpoch) {
+    return QDateTime::fromMSecsSinceEpoch(secsSinceEpoch * 1000, Qt::UTC).date();
+}
+
+} // namespace
+
+qint64 IntradaySeriesCache::lastTimestamp(const QString &extRefId) const {
+    const auto it = cachedSeries.constFind(extRefId);
+    if (it == cachedSeries.constEnd() || it->size() == 0) {
+        return 0;
+    }
+    return it->getTimestamps().last();
+}
+
+int IntradaySeriesCache::merge(const QString &extRefId, const ChartSeriesData &points) {
+    if (points.size() == 0) {
+        return 0;
+    }
+
+    const QVector<qint64> timestamps = points.getTimestamps();
+    const qint64 cachedLastTimestamp = lastTimestamp(extRefId);
+    if (cachedLastTimestamp == 0 || tradingDay(timestamps.first()) != tradingDay(cachedLastTimestamp)) {
+        cachedSeries.insert(extRefId, points);
+        return points.size();
+    }
+
+    // overlapping refreshes may deliver points that were merged already
+    ChartSeriesData &series = cachedSeries[extRefId];
+    const QVector<double> values = points.getValues();
+    int appendedPoints = 0;
+    for (int i = 0; i < timestamps.size(); i++) {
+        if (timestamps.at(i) > cachedLastTimestamp) {
+            series.append(timestamps.at(i) * 1000, values.at(i));
+            appendedPoints++;
+        }
+    }
+    return appendedPoints;
+}
+
+ChartSeriesData IntradaySeriesCache::series(const QString &extRefId) const {
+    return cachedSeries.value(extRefId);
+}
@@ -0,0 +1,43 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef INTRADAY_SERIES_CACHE_H
+#define INTRADAY_SERIES_CACHE_H
+
+#include <QHash>
+#include <QString>
+
+#include "chartseries.h"
+
+/**
+ * Intraday series of the instruments whose chart was loaded. A refresh only parses the points after the
+ * last cached timestamp and merges them - the points of the trading day are not parsed again.
+ */
+class IntradaySeriesCache {
+public:
+    // seconds since epoch of the last cached point - 0 if the instrument is not cached
+    qint64 lastTimestamp(const QString &extRefId) const;
+    // appends the points after the last cached point and returns their number - points of another trading day
+    // replace the cached series
+    int merge(const QString &extRefId, const ChartSeriesData &points);
+    ChartSeriesData series(const QString &extRefId) const;
+
+private:
+    QHash<QString, ChartSeriesData> cachedSeries;
+};
+
+#endif // INTRADAY_SERIES_CACHE_H
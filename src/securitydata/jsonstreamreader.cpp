@@ -0,0 +1,428 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "jsonstreamreader.h"
+#include "../loggingcategories.h"
+
+#include <QDebug>
+
+namespace {
+
+// up to 15 digits fit into the mantissa of a double
+const int MAXIMUM_FAST_NUMBER_DIGITS = 15;
+const double POWERS_OF_TEN[MAXIMUM_FAST_NUMBER_DIGITS + 1]
+    = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+// numbers without exponent and with up to 15 digits - the digits and the power of ten are exact doubles,
+// so the division is correctly rounded like QByteArray::toDouble()
+bool parseSimpleNumber(const char *data, int length, double &result) {
+    int position = 0;
+    const bool negative = (length > 0 && data[0] == '-');
+    if (negative) {
+        position++;
+    }
+
+    qint64 mantissa = 0;
+    int digits = 0;
+    int fractionDigits = -1;
+    for (; position < length; position++) {
+        const char c = data[position];
+        if (c >= '0' && c <= '9') {
+            if (++digits > MAXIMUM_FAST_NUMBER_DIGITS) {
+                return false;
+            }
+            mantissa = mantissa * 10 + (c - '0');
+            if (fractionDigits >= 0) {
+                fractionDigits++;
+            }
+        } else if (c == '.' && fractionDigits < 0) {
+            fractionDigits = 0;
+        } else {
+            return false;
+        }
+    }
+    if (digits == 0 || fractionDigits == 0) {
+        return false;
+    }
+
+    result = static_cast<double>(mantissa);
+    if (fractionDigits > 0) {
+        result /= POWERS_OF_TEN[fractionDigits];
+    }
+    if (negative) {
+        result = -result;
+    }
+    return true;
+}
+
+} // namespace
+
+void JsonStreamReader::addData(const QByteArray &data) {
+    buffer.append(data);
+}
+
+void JsonStreamReader::finish() {
+    finished = true;
+}
+
+QString JsonStreamReader::stringValue() const {
+    return currentIsKey ? containers.last().key : currentString;
+}
+
+double JsonStreamReader::numberValue() const {
+    return currentNumber;
+}
+
+bool JsonStreamReader::booleanValue() const {
+    return currentBoolean;
+}
+
+int JsonStreamReader::depth() const {
+    return containers.size();
+}
+
+QString JsonStreamReader::key(int level) const {
+    return (level >= 0 && level < containers.size()) ? containers.at(level).key : QString();
+}
+
+int JsonStreamReader::index(int level) const {
+    return (level >= 0 && level < containers.size()) ? containers.at(level).index : -1;
+}
+
+int JsonStreamReader::offset() const {
+    return consumed + position;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::readNext() {
+    if (invalid) {
+        return INVALID;
+    }
+    currentIsKey = false;
+
+    // separators carry no information - they are only checked, the containers know whether a key or a value is next
+    for (;;) {
+        while (position < buffer.size()) {
+            const char c = buffer.at(position);
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                break;
+            }
+            position++;
+        }
+        if (position >= buffer.size()) {
+            break;
+        }
+        const char c = buffer.at(position);
+        if (containers.isEmpty()) {
+            if (rootRead) {
+                qCDebug(lcParse) << "JsonStreamReader::readNext - data after the end of the document";
+                invalid = true;
+                return INVALID;
+            }
+            break;
+        }
+        Container &container = containers.last();
+        if (container.afterKey) {
+            if (c != ':') {
+                invalid = true;
+                return INVALID;
+            }
+            container.afterKey = false;
+            position++;
+            continue;
+        }
+        if (container.afterValue && c != '}' && c != ']') {
+            if (c != ',') {
+                invalid = true;
+                return INVALID;
+            }
+            container.afterValue = false;
+            container.afterComma = true;
+            position++;
+            continue;
+        }
+        // a separator without a value before it, a trailing comma or a value that is not a key in an object
+        if (c == ',' || c == ':' || (container.afterComma && (c == '}' || c == ']'))
+            || (container.isObject && container.expectKey && c != '"' && c != '}')) {
+            invalid = true;
+            return INVALID;
+        }
+        break;
+    }
+
+    const int tokenStart = position;
+    if (position >= buffer.size()) {
+        if (!finished) {
+            return needMoreData(tokenStart);
+        }
+        if (!containers.isEmpty()) {
+            qCDebug(lcParse) << "JsonStreamReader::readNext - unexpected end of data";
+            invalid = true;
+            return INVALID;
+        }
+        return END_OF_DATA;
+    }
+
+    const char c = buffer.at(position);
+    switch (c) {
+    case '{':
+    case '[': {
+        beginValue();
+        Container container;
+        container.isObject = (c == '{');
+        container.expectKey = container.isObject;
+        container.afterKey = false;
+        container.afterValue = false;
+        container.afterComma = false;
+        container.index = -1;
+        containers.append(container);
+        position++;
+        return container.isObject ? START_OBJECT : START_ARRAY;
+    }
+    case '}':
+    case ']':
+        if (containers.isEmpty() || containers.last().isObject != (c == '}')) {
+            invalid = true;
+            return INVALID;
+        }
+        containers.removeLast();
+        position++;
+        endValue();
+        return (c == '}') ? END_OBJECT : END_ARRAY;
+    case '"': {
+        const bool isKey = (!containers.isEmpty() && containers.last().isObject && containers.last().expectKey);
+        int endPosition;
+        if (!readString(endPosition, isKey)) {
+            return invalid ? INVALID : needMoreData(tokenStart);
+        }
+        position = endPosition;
+        if (isKey) {
+            containers.last().expectKey = false;
+            containers.last().afterKey = true;
+            containers.last().afterComma = false;
+            currentIsKey = true;
+            return KEY;
+        }
+        beginValue();
+        endValue();
+        return STRING;
+    }
+    case 't':
+    case 'f':
+    case 'n': {
+        const char *literal = "null";
+        if (c == 't') {
+            literal = "true";
+        } else if (c == 'f') {
+            literal = "false";
+        }
+        const int literalLength = static_cast<int>(qstrlen(literal));
+        if (buffer.size() - position < literalLength) {
+            if (finished) {
+                invalid = true;
+                return INVALID;
+            }
+            return needMoreData(tokenStart);
+        }
+        if (qstrncmp(buffer.constData() + position, literal, static_cast<uint>(literalLength)) != 0) {
+            invalid = true;
+            return INVALID;
+        }
+        position += literalLength;
+        beginValue();
+        endValue();
+        if (c == 'n') {
+            return NULL_VALUE;
+        }
+        currentBoolean = (c == 't');
+        return BOOLEAN;
+    }
+    default: {
+        int endPosition = position;
+        while (endPosition < buffer.size()) {
+            const char n = buffer.at(endPosition);
+            if ((n < '0' || n > '9') && n != '-' && n != '+' && n != '.' && n != 'e' && n != 'E') {
+                break;
+            }
+            endPosition++;
+        }
+        // the number may continue in the next chunk
+        if (endPosition == buffer.size() && !finished) {
+            return needMoreData(tokenStart);
+        }
+        bool ok = parseSimpleNumber(buffer.constData() + position, endPosition - position, currentNumber);
+        if (!ok) {
+            currentNumber = buffer.mid(position, endPosition - position).toDouble(&ok);
+        }
+        if (!ok) {
+            invalid = true;
+            return INVALID;
+        }
+        position = endPosition;
+        beginValue();
+        endValue();
+        return NUMBER;
+    }
+    }
+}
+
+void JsonStreamReader::beginValue() {
+    if (containers.isEmpty()) {
+        return;
+    }
+    Container &container = containers.last();
+    if (container.isObject) {
+        container.expectKey = true;
+    } else {
+        container.index++;
+    }
+}
+
+void JsonStreamReader::endValue() {
+    if (containers.isEmpty()) {
+        rootRead = true;
+        return;
+    }
+    Container &container = containers.last();
+    container.afterValue = true;
+    container.afterComma = false;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::needMoreData(int tokenStart) {
+    // everything before the incomplete token is consumed
+    buffer.remove(0, tokenStart);
+    consumed += tokenStart;
+    position = 0;
+    return NEED_MORE_DATA;
+}
+
+QString JsonStreamReader::sharedKey(const char *data, int length) {
+    const QLatin1String latin1Key(data, length);
+    for (int i = 0; i < keys.size(); i++) {
+        if (keys.at(i) == latin1Key) {
+            return keys.at(i);
+        }
+    }
+    const QString key = QString::fromLatin1(data, length);
+    if (keys.size() < JSON_STREAM_READER_MAXIMUM_KEYS) {
+        keys.append(key);
+    }
+    return key;
+}
+
+bool JsonStreamReader::readString(int &endPosition, bool isKey) {
+    int runStart = position + 1;
+    int current = runStart;
+
+    // ascii without escape sequences - keys, timestamps, ids, ...
+    bool ascii = true;
+    while (current < buffer.size()) {
+        const char c = buffer.at(current);
+        if (c == '"' || c == '\\') {
+            break;
+        }
+        if (static_cast<uchar>(c) >= 0x80) {
+            ascii = false;
+        }
+        current++;
+    }
+    if (current < buffer.size() && buffer.at(current) == '"' && ascii) {
+        const char *data = buffer.constData() + runStart;
+        const int length = current - runStart;
+        if (isKey) {
+            containers.last().key = sharedKey(data, length);
+        } else {
+            // no allocation as long as the caller did not keep the previous value
+            currentString.resize(length);
+            QChar *target = currentString.data();
+            for (int i = 0; i < length; i++) {
+                target[i] = QLatin1Char(data[i]);
+            }
+        }
+        endPosition = current + 1;
+        return true;
+    }
+
+    QString result;
+    current = runStart;
+
+    while (current < buffer.size()) {
+        const char c = buffer.at(current);
+        if (c == '"') {
+            result.append(QString::fromUtf8(buffer.constData() + runStart, current - runStart));
+            if (isKey) {
+                containers.last().key = result;
+            } else {
+                currentString = result;
+            }
+            endPosition = current + 1;
+            return true;
+        }
+        if (c != '\\') {
+            current++;
+            continue;
+        }
+
+        result.append(QString::fromUtf8(buffer.constData() + runStart, current - runStart));
+        if (current + 1 >= buffer.size()) {
+            return false;
+        }
+        const char escaped = buffer.at(current + 1);
+        int escapeLength = 2;
+        switch (escaped) {
+        case 'b':
+            result.append(QChar('\b'));
+            break;
+        case 'f':
+            result.append(QChar('\f'));
+            break;
+        case 'n':
+            result.append(QChar('\n'));
+            break;
+        case 'r':
+            result.append(QChar('\r'));
+            break;
+        case 't':
+            result.append(QChar('\t'));
+            break;
+        case 'u': {
+            if (current + 6 > buffer.size()) {
+                return false;
+            }
+            bool ok = false;
+            const ushort unicode = buffer.mid(current + 2, 4).toUShort(&ok, 16);
+            if (!ok) {
+                invalid = true;
+                return false;
+            }
+            result.append(QChar(unicode));
+            escapeLength = 6;
+            break;
+        }
+        default:
+            // \" \\ \/
+            result.append(QChar(escaped));
+            break;
+        }
+        current += escapeLength;
+        runStart = current;
+    }
+
+    if (finished) {
+        invalid = true;
+    }
+    return false;
+}
@@ -0,0 +1,113 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef JSON_STREAM_READER_H
+#define JSON_STREAM_READER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+// distinct keys that are decoded only once per reader
+const int JSON_STREAM_READER_MAXIMUM_KEYS = 64;
+
+/**
+ * Pull parser for json that can be fed in chunks. Unlike QJsonDocument no document tree is built -
+ * the caller reads the tokens one by one and keeps only the values it needs. Consumed data is
+ * dropped from the internal buffer, so the memory does not grow with the size of the response.
+ *
+ * Reading the tokens does not allocate per element: the keys of a response repeat for every element and are
+ * shared, ascii strings are decoded into the buffer of the previous string value and plain numbers are parsed
+ * in place. Callers should compare keys with QLatin1String and must not keep the string value of every element.
+ */
+class JsonStreamReader {
+public:
+    enum TokenType {
+        START_OBJECT,
+        END_OBJECT,
+        START_ARRAY,
+        END_ARRAY,
+        KEY,
+        STRING,
+        NUMBER,
+        BOOLEAN,
+        NULL_VALUE,
+        // the next token is incomplete - call addData() or finish()
+        NEED_MORE_DATA,
+        END_OF_DATA,
+        INVALID
+    };
+
+    JsonStreamReader() = default;
+
+    void addData(const QByteArray &data);
+    // no more data will be added
+    void finish();
+
+    TokenType readNext();
+
+    // value of the last KEY or STRING token
+    QString stringValue() const;
+    double numberValue() const;
+    bool booleanValue() const;
+
+    // number of open objects / arrays
+    int depth() const;
+    // key of the current value in the object at the given level (0 is the outermost container)
+    QString key(int level) const;
+    // index of the current element in the array at the given level
+    int index(int level) const;
+    // number of bytes of all added data that were read - the end of the last token
+    int offset() const;
+
+private:
+    struct Container
+    {
+        bool isObject;
+        bool expectKey;
+        // the separator that has to follow - ':' after a key, ',' or the end of the container after a value
+        bool afterKey;
+        bool afterValue;
+        bool afterComma;
+        int index;
+        QString key;
+    };
+
+    QByteArray buffer;
+    int position = 0;
+    // bytes that were dropped from the buffer
+    int consumed = 0;
+    bool finished = false;
+    bool invalid = false;
+    // the outermost value is complete - only whitespace may follow
+    bool rootRead = false;
+    QVector<Container> containers;
+    QVector<QString> keys;
+
+    QString currentString;
+    bool currentIsKey = false;
+    double currentNumber = 0.0;
+    bool currentBoolean = false;
+
+    void beginValue();
+    void endValue();
+    TokenType needMoreData(int tokenStart);
+    bool readString(int &endPosition, bool isKey);
+    QString sharedKey(const char *data, int length);
+};
+
+#endif // JSON_STREAM_READER_H
@@ -16,82 +16,368 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "moscowexchangebackend.h"
-#include "chartdatacalculator.h"
+#include "../loggingcategories.h"
+#include "backenddescriptor.h"
+#include "chartseries.h"
+#include "jsonstreamreader.h"
+#include "../network/quotebatcher.h"
 
 #include "../constants.h"
+#include "../timestamputils.h"
 
+#include <QDate>
 #include <QDateTime>
 #include <QDebug>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QTimeZone>
 #include <QUrl>
 #include <QUrlQuery>
 #include <QUuid>
 #include <QVariantMap>
 
-MoscowExchangeBackend::MoscowExchangeBackend(QNetworkAccessManager *manager, QObject *parent)
-    : AbstractDataBackend(manager, parent) {
-    qDebug() << "Initializing Moscow Exchange Backend...";
+namespace {
+
+constexpr BackendDescriptor MOSCOW_EXCHANGE_DESCRIPTOR = {MOSCOW_EXCHANGE_API_SEARCH,
+                                                          MOSCOW_EXCHANGE_QUOTE,
+                                                          MOSCOW_EXCHANGE_API_CANDLES,
+                                                          nullptr,
+                                                          AbstractDataBackend::INTRADAY | AbstractDataBackend::MONTH
+                                                              | AbstractDataBackend::THREE_MONTHS
+                                                              | AbstractDataBackend::YEAR
+                                                              | AbstractDataBackend::THREE_YEARS
+                                                              | AbstractDataBackend::FIVE_YEARS};
+
+// candle intervals of the api
+constexpr int MOSCOW_EXCHANGE_INTERVAL_MINUTE = 1;
+constexpr int MOSCOW_EXCHANGE_INTERVAL_DAY = 24;
+constexpr int MOSCOW_EXCHANGE_INTERVAL_WEEK = 7;
+
+struct CandleInterval
+{
+    int chartType;
+    int interval;
+};
+
+// the server aggregates the candles - the long ranges transfer a point per day or week
+constexpr CandleInterval MOSCOW_EXCHANGE_CANDLE_INTERVALS[]
+    = {{AbstractDataBackend::INTRADAY, MOSCOW_EXCHANGE_INTERVAL_MINUTE},
+       {AbstractDataBackend::MONTH, MOSCOW_EXCHANGE_INTERVAL_DAY},
+       {AbstractDataBackend::THREE_MONTHS, MOSCOW_EXCHANGE_INTERVAL_DAY},
+       {AbstractDataBackend::YEAR, MOSCOW_EXCHANGE_INTERVAL_DAY},
+       {AbstractDataBackend::THREE_YEARS, MOSCOW_EXCHANGE_INTERVAL_WEEK},
+       {AbstractDataBackend::FIVE_YEARS, MOSCOW_EXCHANGE_INTERVAL_WEEK}};
+static_assert(coversChartTypes(MOSCOW_EXCHANGE_CANDLE_INTERVALS, MOSCOW_EXCHANGE_DESCRIPTOR.supportedChartTypes),
+              "every supported chart type needs a candle interval");
+
+// the responses are tables - the sources are column names, their positions are taken from the "columns" array
+constexpr FieldMapping MOSCOW_EXCHANGE_SEARCH_FIELDS[] = {{"extRefId", "secid"},
+                                                          {"symbol1", "secid"},
+                                                          {"name", "name"},
+                                                          {"isin", "isin"},
+                                                          {"stockMarketName", "primary_boardid"},
+                                                          // not persisted - displayed on the add stock page
+                                                          {"genericText1", "primary_boardid"}};
+static_assert(isValidMapping(MOSCOW_EXCHANGE_SEARCH_FIELDS), "invalid search field mapping");
+
+// currency and timestamps are converted
+constexpr FieldMapping MOSCOW_EXCHANGE_SECURITIES_FIELDS[] = {{"name", "SHORTNAME"}, {"isin", "ISIN"}};
+static_assert(isValidMapping(MOSCOW_EXCHANGE_SECURITIES_FIELDS), "invalid securities field mapping");
+
+constexpr FieldMapping MOSCOW_EXCHANGE_MARKET_DATA_FIELDS[] = {{"extRefId", "SECID"},
+                                                               {"symbol1", "SECID"},
+                                                               {"stockMarketName", "BOARDID"},
+                                                               {"price", "LCLOSEPRICE"},
+                                                               {"high", "HIGH"},
+                                                               {"low", "LOW"},
+                                                               {"volume", "VOLTODAY"},
+                                                               {"changeAbsolute", "CHANGE"},
+                                                               {"changeRelative", "LASTTOPREVPRICE"}};
+static_assert(isValidMapping(MOSCOW_EXCHANGE_MARKET_DATA_FIELDS), "invalid market data field mapping");
+
+// columns that are read without a mapping table
+constexpr const char *const MOSCOW_EXCHANGE_SECURITIES_COLUMNS[] = {"CURRENCYID"};
+constexpr const char *const MOSCOW_EXCHANGE_MARKET_DATA_COLUMNS[] = {"SYSTIME", "UPDATETIME"};
+constexpr const char *const MOSCOW_EXCHANGE_CANDLES_COLUMNS[] = {"begin", "close"};
+
+template <int N>
+void appendColumns(QStringList &columns, const FieldMapping (&fields)[N]) {
+    for (const FieldMapping &field : fields) {
+        const QString column = QString::fromLatin1(field.sourceKey);
+        if (!columns.contains(column)) {
+            columns.append(column);
+        }
+    }
+}
+
+template <int N>
+void appendColumns(QStringList &columns, const char *const (&columnNames)[N]) {
+    for (const char *columnName : columnNames) {
+        columns.append(QString::fromLatin1(columnName));
+    }
+}
+
+// the projections are derived from the columns that are parsed - they are created once
+const QString &searchProjection() {
+    static const QString projection = [] {
+        QStringList securitiesColumns;
+        appendColumns(securitiesColumns, MOSCOW_EXCHANGE_SEARCH_FIELDS);
+        return QString(MOSCOW_EXCHANGE_SEARCH_PROJECTION).arg(securitiesColumns.join(","));
+    }();
+    return projection;
+}
+
+const QString &quoteProjection() {
+    static const QString projection = [] {
+        QStringList securitiesColumns;
+        appendColumns(securitiesColumns, MOSCOW_EXCHANGE_SECURITIES_FIELDS);
+        appendColumns(securitiesColumns, MOSCOW_EXCHANGE_SECURITIES_COLUMNS);
+        QStringList marketDataColumns;
+        appendColumns(marketDataColumns, MOSCOW_EXCHANGE_MARKET_DATA_FIELDS);
+        appendColumns(marketDataColumns, MOSCOW_EXCHANGE_MARKET_DATA_COLUMNS);
+        return QString(MOSCOW_EXCHANGE_QUOTE_PROJECTION).arg(securitiesColumns.join(","), marketDataColumns.join(","));
+    }();
+    return projection;
+}
+
+const QString &candlesProjection() {
+    static const QString projection = [] {
+        QStringList candlesColumns;
+        appendColumns(candlesColumns, MOSCOW_EXCHANGE_CANDLES_COLUMNS);
+        return QString(MOSCOW_EXCHANGE_CANDLES_PROJECTION).arg(candlesColumns.join(","));
+    }();
+    return projection;
+}
+
+int candleInterval(int chartType) {
+    for (const CandleInterval &candleInterval : MOSCOW_EXCHANGE_CANDLE_INTERVALS) {
+        if (candleInterval.chartType == chartType) {
+            return candleInterval.interval;
+        }
+    }
+    return MOSCOW_EXCHANGE_INTERVAL_DAY;
+}
+
+// the intraday chart shows the last trading day - there are no candles of the current day on weekends
+QDate lastTradingDay() {
+    QDate date = QDate::currentDate();
+    while (date.dayOfWeek() >= Qt::Saturday) {
+        date = date.addDays(-1);
+    }
+    return date;
+}
+
+// the exchange trades on weekdays - holidays make the estimate too high, a page more than needed is returned empty
+int estimateChartPages(int interval, const QDate &startDate, const QDate &endDate) {
+    const qint64 days = startDate.daysTo(endDate) + 1;
+    qint64 candles = 0;
+    if (interval == MOSCOW_EXCHANGE_INTERVAL_MINUTE) {
+        candles = MOSCOW_EXCHANGE_INTRADAY_CANDLES;
+    } else if (interval == MOSCOW_EXCHANGE_INTERVAL_WEEK) {
+        candles = days / 7 + 1;
+    } else {
+        candles = (days / 7) * 5;
+        for (QDate date = startDate.addDays((days / 7) * 7); date <= endDate; date = date.addDays(1)) {
+            if (date.dayOfWeek() < Qt::Saturday) {
+                candles++;
+            }
+        }
+    }
+    return qMax(1,
+                static_cast<int>((candles + MOSCOW_EXCHANGE_CANDLES_PAGE_SIZE - 1)
+                                 / MOSCOW_EXCHANGE_CANDLES_PAGE_SIZE));
+}
+
+void logMissingColumns(const char *table, const QStringList &missingColumns) {
+    if (!missingColumns.isEmpty()) {
+        qCWarning(lcParse) << "MoscowExchangeBackend - columns missing in" << table << ":" << missingColumns;
+    }
+}
+
+} // namespace
+
+MoscowExchangeBackend::MoscowExchangeBackend(NetworkService *networkService, QObject *parent)
+    : AbstractDataBackend(networkService, parent) {
+    qCDebug(lcParse) << "Initializing Moscow Exchange Backend...";
     // debug mode when we want to see everything in english
     // debugMode = true;
-    this->supportedChartTypes = (ChartType::MONTH | ChartType::THREE_MONTHS);
+    this->supportedChartTypes = MOSCOW_EXCHANGE_DESCRIPTOR.supportedChartTypes;
 }
 
 MoscowExchangeBackend::~MoscowExchangeBackend() {
-    qDebug() << "Shutting down Moscow Exchange Backend...";
+    qCDebug(lcParse) << "Shutting down Moscow Exchange Backend...";
 }
 
-void MoscowExchangeBackend::searchName(const QString &searchString) {
-    qDebug() << "MoscowExchangeBackend::searchName";
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(MOSCOW_EXCHANGE_API_SEARCH).arg(searchString, getLanguage())));
+void MoscowExchangeBackend::searchName(const QString &searchString, const int requestId) {
+    qCDebug(lcParse) << "MoscowExchangeBackend::searchName";
+    PendingReply *reply = executeGetRequest(
+        QUrl(QString(MOSCOW_EXCHANGE_DESCRIPTOR.searchUrl).arg(searchString, getLanguage()) + searchProjection()),
+        requestId);
 
     connectErrorSlot(reply);
     connect(reply, SIGNAL(finished()), this, SLOT(handleSearchNameFinished()));
 }
 
-void MoscowExchangeBackend::searchQuoteForNameSearch(const QString &searchString) {
+void MoscowExchangeBackend::searchQuoteForNameSearch(const QString &searchString, const int requestId) {
     // TODO check if needed
-    qDebug() << "MoscowExchangeBackend::searchQuoteForNameSearch";
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(MOSCOW_EXCHANGE_QUOTE).arg(searchString, getLanguage())));
+    qCDebug(lcParse) << "MoscowExchangeBackend::searchQuoteForNameSearch";
+    PendingReply *reply = executeGetRequest(
+        QUrl(QString(MOSCOW_EXCHANGE_DESCRIPTOR.quoteUrl).arg(searchString, getLanguage()) + quoteProjection()),
+        requestId);
 
     connectErrorSlot(reply);
     connect(reply, SIGNAL(finished()), this, SLOT(handleSearchQuoteForNameFinished()));
 }
 
-void MoscowExchangeBackend::fetchPricesForChart(const QString &extRefId, const int chartType) {
-    qDebug() << "MoscowExchangeBackend::fetchClosePrices";
+void MoscowExchangeBackend::fetchPricesForChart(const QString &extRefId, const int chartType, const int requestId) {
+    qCDebug(lcChart) << "MoscowExchangeBackend::fetchClosePrices";
 
     if (!isChartTypeSupported(chartType)) {
-        qDebug() << "MoscowExchangeBackend::fetchClosePrices - chart type " << chartType << " not supported!";
+        qCDebug(lcChart) << "MoscowExchangeBackend::fetchClosePrices - chart type " << chartType << " not supported!";
         return;
     }
 
-    QString startDateString = getStartDateForChart(chartType).toString("yyyy-MM-dd");
+    // a running fetch of the same chart is superseded - its pages are dropped when they arrive
+    QMutableHashIterator<int, ChartFetch> chartFetchIterator(chartFetches);
+    while (chartFetchIterator.hasNext()) {
+        const ChartFetch &chartFetch = chartFetchIterator.next().value();
+        if (chartFetch.extRefId == extRefId && chartFetch.chartType == chartType) {
+            discardRequest(chartFetch.requestId);
+            chartFetchIterator.remove();
+        }
+    }
+
+    const QDate startDate = (chartType == INTRADAY ? lastTradingDay() : getStartDateForChart(chartType));
+    const int interval = candleInterval(chartType);
+    const int pageCount = estimateChartPages(interval, startDate, QDate::currentDate());
+
+    ChartFetch chartFetch;
+    chartFetch.extRefId = extRefId;
+    chartFetch.chartType = chartType;
+    chartFetch.interval = interval;
+    chartFetch.requestId = requestId;
+    chartFetch.startDate = startDate.toString("yyyy-MM-dd");
+    chartFetch.pages.resize(pageCount);
+    chartFetch.pendingPages = pageCount;
+    const int fetchId = ++lastChartFetchId;
+    chartFetches.insert(fetchId, chartFetch);
+
+    // the offsets are known up front - all pages are requested at once, the scheduler limits the concurrency
+    for (int page = 0; page < pageCount; page++) {
+        fetchChartPage(fetchId, page);
+    }
+}
 
-    // so far we get all data from the same service
-    QNetworkReply *reply = executeGetRequest(
-        QUrl(QString(MOSCOW_EXCHANGE_API_CLOSE_PRICES).arg(extRefId, startDateString, getLanguage())));
+void MoscowExchangeBackend::fetchChartPage(const int fetchId, const int page) {
+    ChartFetch &chartFetch = chartFetches[fetchId];
+    const QString chartUrl = QString(MOSCOW_EXCHANGE_DESCRIPTOR.chartUrl)
+                                 .arg(chartFetch.extRefId, chartFetch.startDate)
+                                 .arg(chartFetch.interval);
+    PendingReply *reply = executeGetRequest(
+        QUrl(chartUrl + candlesProjection()
+             + QString(MOSCOW_EXCHANGE_CANDLES_START).arg(page * MOSCOW_EXCHANGE_CANDLES_PAGE_SIZE)),
+        chartFetch.requestId);
+    if (page == 0) {
+        chartFetch.requestTag = reply->tag();
+    }
 
+    const int interval = chartFetch.interval;
     connectErrorSlot(reply);
-    connect(reply, &QNetworkReply::finished, this, &MoscowExchangeBackend::handleFetchPricesForChartFinished);
+    connect(reply, &PendingReply::finished, this, [this, reply, fetchId, page, interval]() {
+        reply->deleteLater();
+        if (!chartFetches.contains(fetchId)) {
+            return;
+        }
+        if (reply->error() != QNetworkReply::NoError) {
+            // also an aborted page, e.g. the chart page was left - the request is discarded
+            abortChartFetch(fetchId);
+            return;
+        }
+        networkService->processInBackground(
+            reply->readAll(),
+            [this, interval](const QByteArray &data) { return parseCandlesResponse(data, interval); },
+            this,
+            [this, fetchId, page](const QVariant &chartSeriesData) {
+                processChartPage(fetchId, page, chartSeriesData);
+            },
+            reply->tag(),
+            [this, fetchId]() { abortChartFetch(fetchId); });
+    });
+}
 
-    reply->setProperty("type", chartType);
+void MoscowExchangeBackend::abortChartFetch(const int fetchId) {
+    // the other pages of the fetch find it gone when they arrive
+    if (chartFetches.contains(fetchId)) {
+        discardRequest(chartFetches.take(fetchId).requestId);
+    }
 }
 
-void MoscowExchangeBackend::searchQuote(const QString &searchString) {
-    // TODO check if needed
-    qDebug() << "MoscowExchangeBackend::searchQuote";
-    QNetworkReply *reply = executeGetRequest(QUrl(QString(MOSCOW_EXCHANGE_QUOTE).arg(searchString, getLanguage())));
+void MoscowExchangeBackend::processChartPage(const int fetchId, const int page, const QVariant &chartSeriesData) {
+    qCDebug(lcChart) << "MoscowExchangeBackend::processChartPage" << fetchId << page;
+    if (!chartFetches.contains(fetchId)) {
+        return;
+    }
+    if (!chartSeriesData.isValid()) {
+        discardRequest(chartFetches.take(fetchId).requestId);
+        return;
+    }
+
+    ChartFetch &chartFetch = chartFetches[fetchId];
+    chartFetch.pages[page] = chartSeriesData.value<ChartSeriesData>();
+    if (--chartFetch.pendingPages > 0) {
+        return;
+    }
+
+    // a full last page means the estimate was too low (e.g. trading on a saturday) - the next page is fetched
+    if (chartFetch.pages.last().size() == MOSCOW_EXCHANGE_CANDLES_PAGE_SIZE) {
+        const int nextPage = chartFetch.pages.size();
+        chartFetch.pages.resize(nextPage + 1);
+        chartFetch.pendingPages = 1;
+        networkService->beginRequestScope(chartFetch.requestTag);
+        fetchChartPage(fetchId, nextPage);
+        networkService->endRequestScope();
+        return;
+    }
+
+    // the pages are stitched in the order of their offsets - independent of the order they arrived in
+    ChartSeriesData stitchedChartSeriesData;
+    int size = 0;
+    for (const ChartSeriesData &pageData : chartFetch.pages) {
+        size += pageData.size();
+    }
+    stitchedChartSeriesData.reserve(size);
+    for (const ChartSeriesData &pageData : chartFetch.pages) {
+        stitchedChartSeriesData.append(pageData);
+    }
+    const int chartType = chartFetch.chartType;
+    const int requestId = chartFetch.requestId;
+    chartFetches.remove(fetchId);
 
+    deliverChartSeries(requestId, QVariant::fromValue(stitchedChartSeriesData), chartType);
+}
+
+QList<QStringList> MoscowExchangeBackend::splitQuoteBatches(const QStringList &extRefIds) {
+    // the ids are placed in the middle of the url - the rest of the url counts as prefix
+    const int urlLength = QString(MOSCOW_EXCHANGE_DESCRIPTOR.quoteUrl).arg(QString(), getLanguage()).length()
+                          + quoteProjection().length();
+    return QuoteBatcher::splitIds(extRefIds, urlLength, QUOTE_BATCH_MAXIMUM_URL_LENGTH);
+}
+
+PendingReply *MoscowExchangeBackend::executeQuoteBatchRequest(const QStringList &extRefIds,
+                                                              RequestScheduler::RequestPriority priority) {
+    PendingReply *reply = executeGetRequest(
+        QUrl(QString(MOSCOW_EXCHANGE_DESCRIPTOR.quoteUrl).arg(extRefIds.join(","), getLanguage()) + quoteProjection()),
+        0,
+        priority);
     connectErrorSlot(reply);
-    connect(reply, SIGNAL(finished()), this, SLOT(handleSearchQuoteFinished()));
+    return reply;
 }
 
 void MoscowExchangeBackend::handleSearchNameFinished() {
-    qDebug() << "MoscowExchangeBackend::handleSearchNameFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcParse) << "MoscowExchangeBackend::handleSearchNameFinished";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
@@ -100,133 +386,122 @@ void MoscowExchangeBackend::handleSearchNameFinished() {
     QByteArray searchReply = reply->readAll();
     QJsonDocument jsonDocument = QJsonDocument::fromJson(searchReply);
     if (jsonDocument.isObject()) {
-        emit searchResultAvailable(processSearchResult(searchReply));
+        deliverSearchResult(requestIdOf(reply), processSearchResult(searchReply));
     } else {
-        qDebug() << "not a json object !";
+        qCDebug(lcParse) << "not a json object !";
+        discardRequest(requestIdOf(reply));
     }
 }
 
 void MoscowExchangeBackend::handleSearchQuoteForNameFinished() {
-    qDebug() << "MoscowExchangeBackend::handleSearchQuoteForNameFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    qCDebug(lcParse) << "MoscowExchangeBackend::handleSearchQuoteForNameFinished";
+    PendingReply *reply = qobject_cast<PendingReply *>(sender());
     reply->deleteLater();
     if (reply->error() != QNetworkReply::NoError) {
         return;
     }
 
-    emit searchResultAvailable(processSearchResult(reply->readAll()));
+    deliverSearchResult(requestIdOf(reply), processSearchResult(reply->readAll()));
 }
 
-void MoscowExchangeBackend::handleSearchQuoteFinished() {
-    qDebug() << "MoscowExchangeBackend::handleSearchQuoteForNameFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    reply->deleteLater();
-    if (reply->error() != QNetworkReply::NoError) {
-        return;
-    }
-
-    emit quoteResultAvailable(processQuoteResult(reply->readAll()));
-}
+QVariant MoscowExchangeBackend::parseCandlesResponse(const QByteArray &reply, const int interval) {
+    JsonStreamReader reader;
+    reader.addData(reply);
+    reader.finish();
 
-void MoscowExchangeBackend::handleFetchPricesForChartFinished() {
-    qDebug() << "MoscowExchangeBackend::handleFetchPricesForChartFinished";
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    reply->deleteLater();
-    if (reply->error() != QNetworkReply::NoError) {
-        return;
+    if (reader.readNext() != JsonStreamReader::START_OBJECT) {
+        qCDebug(lcParse) << "not a json object!";
+        return QVariant();
     }
 
-    QByteArray resultByteArray = reply->readAll();
-    QString result = QString(resultByteArray);
-
-    qDebug() << "MoscowExchangeBackend::handleFetchPricesForChartFinished result " << result;
-
-    QString jsonResponseString = parsePriceResponse(resultByteArray);
-
-    if (!jsonResponseString.isNull()) {
-        emit fetchPricesForChartAvailable(jsonResponseString, reply->property("type").toInt());
-    }
-}
-
-QString MoscowExchangeBackend::parsePriceResponse(QByteArray reply) {
-    QJsonDocument jsonDocument = QJsonDocument::fromJson(reply);
-    if (!jsonDocument.isObject()) {
-        qDebug() << "not a json object!";
-        return QString();
+    // { "candles": { "columns": [ "close", "begin" ], "data": [ [ 272.5, "2021-01-04 10:00:00" ], ... ] } }
+    // the columns are listed before the data - the positions are resolved by name, so the projection may change
+    ChartSeriesData chartSeriesData;
+    // every candle is an array of at most one page - the opening brackets bound the points of the response
+    chartSeriesData.reserve(qMin(reply.count('['), MOSCOW_EXCHANGE_CANDLES_PAGE_SIZE));
+    // the candles begin at the moscow wall clock time
+    TimeZoneOffsetCache &moscowTimeZone = TimeZoneOffsetCache::forTimeZone(QTimeZone("Europe/Moscow"));
+    const bool intraday = (interval == MOSCOW_EXCHANGE_INTERVAL_MINUTE);
+    int beginColumn = -1;
+    int closeColumn = -1;
+    qint64 mSecsSinceEpoch = 0;
+    double closeValue = 0.0;
+    qint64 wallMSecs;
+    int offsetSeconds;
+
+    JsonStreamReader::TokenType token;
+    while ((token = reader.readNext()) != JsonStreamReader::END_OF_DATA) {
+        if (token == JsonStreamReader::INVALID) {
+            qCWarning(lcParse) << "MoscowExchangeBackend::parseCandlesResponse - invalid json";
+            return QVariant();
+        }
+        if (reader.key(0) != QLatin1String("candles")) {
+            continue;
+        }
+        if (reader.key(1) == QLatin1String("columns")) {
+            if (reader.depth() == 3 && token == JsonStreamReader::STRING) {
+                if (reader.stringValue() == QLatin1String("begin")) {
+                    beginColumn = reader.index(2);
+                } else if (reader.stringValue() == QLatin1String("close")) {
+                    closeColumn = reader.index(2);
+                }
+            }
+            continue;
+        }
+        if (reader.key(1) != QLatin1String("data")) {
+            continue;
+        }
+        if (reader.depth() == 4) {
+            if (reader.index(3) == beginColumn && token == JsonStreamReader::STRING) {
+                if (intraday) {
+                    mSecsSinceEpoch = TimestampUtils::parseIsoDateTime(reader.stringValue(), wallMSecs, offsetSeconds)
+                        ? moscowTimeZone.wallTimeToUtc(wallMSecs)
+                        : 0;
+                } else {
+                    // day and week candles begin at midnight - artifical time, since we do not display the time
+                    mSecsSinceEpoch = TimestampUtils::localDateTimeToMSecs(reader.stringValue(), 18 * 3600);
+                }
+            } else if (reader.index(3) == closeColumn && token == JsonStreamReader::NUMBER) {
+                closeValue = reader.numberValue();
+            }
+        } else if (reader.depth() == 3 && token == JsonStreamReader::END_ARRAY) {
+            chartSeriesData.append(mSecsSinceEpoch, closeValue);
+            mSecsSinceEpoch = 0;
+            closeValue = 0.0;
+        }
     }
 
-    QJsonObject responseObject = jsonDocument.object();
-    QJsonObject historyObject = responseObject["history"].toObject();
-    QJsonArray responseArray = historyObject["data"].toArray();
-
-    QJsonDocument resultDocument;
-    QJsonArray resultArray;
-
-    ChartDataCalculator chartDataCalculator;
-
-    foreach (const QJsonValue &value, responseArray) {
-        QJsonArray valueArray = value.toArray();
-        QJsonObject resultObject;
-
-        QString tradeDate = valueArray.at(1).toString(); // TRADEDATE
-        // artifical time - irrelevant - since we do not display the time for these history entries
-        QString tradeDateTime = tradeDate + " 18:00:00";
-        QDateTime dateTimeTradeDate = QDateTime::fromString(tradeDateTime, Qt::ISODate);
-
-        QJsonValue closeObject = valueArray.at(11); // CLOSE
-        double closeValue = closeObject.toDouble();
-
-        chartDataCalculator.checkCloseValue(closeValue);
-
-        resultObject.insert("x", dateTimeTradeDate.toMSecsSinceEpoch() / 1000);
-        resultObject.insert("y", closeValue);
-
-        resultArray.push_back(resultObject);
+    if (beginColumn < 0 || closeColumn < 0) {
+        qCWarning(lcParse) << "MoscowExchangeBackend::parseCandlesResponse - columns begin / close missing";
+        return QVariant();
     }
 
-    // resultDocument.setArray(resultArray);
-    QJsonObject resultObject;
-    resultObject.insert("min", chartDataCalculator.getMinValue());
-    resultObject.insert("max", chartDataCalculator.getMaxValue());
-    resultObject.insert("fractionDigits", chartDataCalculator.getFractionDigits());
-    resultObject.insert("data", resultArray);
-
-    resultDocument.setObject(resultObject);
-
-    QString dataToString(resultDocument.toJson());
-    return dataToString;
+    return QVariant::fromValue(chartSeriesData);
 }
 
-QString MoscowExchangeBackend::processSearchResult(QByteArray searchReply) {
-    qDebug() << "MoscowExchangeBackend::processSearchResult";
+QString MoscowExchangeBackend::processSearchResult(const QByteArray &searchReply) {
+    qCDebug(lcParse) << "MoscowExchangeBackend::processSearchResult";
     QJsonDocument jsonDocument = QJsonDocument::fromJson(searchReply);
     if (!jsonDocument.isObject()) {
-        qDebug() << "not a json object!";
+        qCDebug(lcParse) << "not a json object!";
     }
 
     QJsonObject responseObject = jsonDocument.object();
     QJsonObject securitiesObject = responseObject["securities"].toObject();
     QJsonArray dataArray = securitiesObject["data"].toArray();
 
-    //    QJsonObject columnsObject = securitiesObject["columns"].toObject();
-    //    QJsonObject metadataObject = securitiesObject["metadata"].toObject();
+    const auto searchFieldMapper = columnFieldMapper(MOSCOW_EXCHANGE_SEARCH_FIELDS,
+                                                     securitiesObject["columns"].toArray());
+    logMissingColumns("securities", searchFieldMapper.getMissingColumns());
 
     QJsonDocument resultDocument;
     QJsonArray resultArray;
 
     foreach (const QJsonValue &value, dataArray) {
-        QJsonArray resultDataArray = value.toArray();
-
         // id is not mapped so far - is it used ??
         QJsonObject resultObject;
-        resultObject.insert("extRefId", resultDataArray.at(1));         // secId
-        resultObject.insert("symbol1", resultDataArray.at(1));          // secId
-        resultObject.insert("name", resultDataArray.at(4));             // name
-        resultObject.insert("isin", resultDataArray.at(5));             // isin
-        resultObject.insert("stockMarketName", resultDataArray.at(14)); // primary_boardid
-        resultObject.insert("currency", "-");                           // dummy for currency
-        // not persisted - displayed on the add stock page
-        resultObject.insert("genericText1", resultDataArray.at(14)); // stockMarketName
+        searchFieldMapper.map(value.toArray(), resultObject);
+        resultObject.insert("currency", "-"); // dummy for currency
 
         resultArray.push_back(resultObject);
     }
@@ -237,11 +512,10 @@ QString MoscowExchangeBackend::processSearchResult(QByteArray searchReply) {
     return dataToString;
 }
 
-QString MoscowExchangeBackend::processQuoteResult(QByteArray searchReply) {
-    qDebug() << "MoscowExchangeBackend::processQuoteResult";
-    QJsonDocument jsonDocument = QJsonDocument::fromJson(searchReply);
+QJsonArray MoscowExchangeBackend::parseQuoteBatch(const QByteArray &quoteReply) {
+    QJsonDocument jsonDocument = QJsonDocument::fromJson(quoteReply);
     if (!jsonDocument.isObject()) {
-        qDebug() << "not a json object!";
+        qCDebug(lcParse) << "not a json object!";
     }
 
     QJsonObject responseObject = jsonDocument.object();
@@ -250,48 +524,47 @@ QString MoscowExchangeBackend::processQuoteResult(QByteArray searchReply) {
     QJsonArray dataArray = securitiesObject["data"].toArray();
     QJsonArray marketDataArray = marketDataObject["data"].toArray();
 
-    //    QJsonObject columnsObject = securitiesObject["columns"].toObject();
-    //    QJsonObject metadataObject = securitiesObject["metadata"].toObject();
+    // the column positions are resolved once per response
+    const QJsonArray securitiesColumns = securitiesObject["columns"].toArray();
+    const QJsonArray marketDataColumns = marketDataObject["columns"].toArray();
+    const auto securitiesFieldMapper = columnFieldMapper(MOSCOW_EXCHANGE_SECURITIES_FIELDS, securitiesColumns);
+    const auto marketDataFieldMapper = columnFieldMapper(MOSCOW_EXCHANGE_MARKET_DATA_FIELDS, marketDataColumns);
+    logMissingColumns("securities", securitiesFieldMapper.getMissingColumns());
+    logMissingColumns("marketdata", marketDataFieldMapper.getMissingColumns());
+    const int currencyColumn = columnIndex(securitiesColumns, QLatin1String("CURRENCYID"));
+    const int sysTimeColumn = columnIndex(marketDataColumns, QLatin1String("SYSTIME"));
+    const int updateTimeColumn = columnIndex(marketDataColumns, QLatin1String("UPDATETIME"));
 
-    QJsonDocument resultDocument;
     QJsonArray resultArray;
 
     if (dataArray.size() != marketDataArray.size()) {
-        qDebug() << "data arrays do not have the same size!";
+        qCDebug(lcParse) << "data arrays do not have the same size!";
     }
 
     int dataLength = dataArray.size();
 
+    // the same for all quotes of the response
+    QDateTime dateTimeNow = QDateTime::currentDateTime();
+    const QString nowString = dateTimeNow.toString("yyyy-MM-dd") + " " + dateTimeNow.toString("hh:mm:ss");
+
     for (int i = 0; i < dataLength; i++) {
         QJsonArray tmpMarketDataArray = marketDataArray.at(i).toArray();
         QJsonArray tmpDataArray = dataArray.at(i).toArray();
 
         // id is not mapped so far - is it used ??
         QJsonObject resultObject;
+        securitiesFieldMapper.map(tmpDataArray, resultObject);
+        marketDataFieldMapper.map(tmpMarketDataArray, resultObject);
 
-        // read from securities data
-        resultObject.insert("name", tmpDataArray.at(2));                                        // name
-        resultObject.insert("isin", tmpDataArray.at(19));                                       // isin
-        resultObject.insert("currency", convertCurrency(tmpDataArray.at(24).toString()));       // CURRENCYID
-        resultObject.insert("currencySymbol", convertCurrency(tmpDataArray.at(24).toString())); // CURRENCYID
-
-        // read from marketdata data
-        resultObject.insert("extRefId", tmpMarketDataArray.at(0));        // secId
-        resultObject.insert("symbol1", tmpMarketDataArray.at(0));         // secId
-        resultObject.insert("stockMarketName", tmpMarketDataArray.at(1)); // primary_boardid
-
-        resultObject.insert("price", tmpMarketDataArray.at(36));          // LCLOSEPRICE
-        resultObject.insert("high", tmpMarketDataArray.at(11));           // HIGH
-        resultObject.insert("low", tmpMarketDataArray.at(10));            // LOW
-        resultObject.insert("volume", tmpMarketDataArray.at(27));         // VOLTODAY
-        resultObject.insert("changeAbsolute", tmpMarketDataArray.at(41)); // CHANGE
-        resultObject.insert("changeRelative", tmpMarketDataArray.at(25)); // LASTTOPREVPRICE
+        const QString currency = convertCurrency(tmpDataArray.at(currencyColumn).toString());
+        resultObject.insert("currency", currency);
+        resultObject.insert("currencySymbol", currency);
 
         QString timestampString = QString("");
-        QString systimeString = tmpMarketDataArray.at(48).toString();
+        QString systimeString = tmpMarketDataArray.at(sysTimeColumn).toString();
         if (!systimeString.isEmpty() && systimeString.length() > 10) {
             timestampString.append(systimeString.mid(0, 10));
-            QString updateTimeString = tmpMarketDataArray.at(32).toString();
+            QString updateTimeString = tmpMarketDataArray.at(updateTimeColumn).toString();
             if (!updateTimeString.isEmpty()) {
                 timestampString.append(" ");
                 timestampString.append(updateTimeString);
@@ -299,17 +572,12 @@ QString MoscowExchangeBackend::processQuoteResult(QByteArray searchReply) {
             resultObject.insert("quoteTimestamp", timestampString);
         }
 
-        QDateTime dateTimeNow = QDateTime::currentDateTime();
-        QString nowString = dateTimeNow.toString("yyyy-MM-dd") + " " + dateTimeNow.toString("hh:mm:ss");
         resultObject.insert("lastChangeTimestamp", nowString);
 
         resultArray.push_back(resultObject);
     }
 
-    resultDocument.setArray(resultArray);
-    QString dataToString(resultDocument.toJson());
-
-    return dataToString;
+    return resultArray;
 }
 
 QString MoscowExchangeBackend::convertCurrency(const QString &currencyString) {
@@ -20,41 +20,69 @@
 
 #include "abstractdatabackend.h"
 
-#include <QNetworkAccessManager>
+#include <QHash>
 #include <QNetworkReply>
 #include <QObject>
+#include <QVector>
+
+// the candles api returns at most 500 candles per request
+const int MOSCOW_EXCHANGE_CANDLES_PAGE_SIZE = 500;
+// one minute candles of a trading day (main and evening session) - used to estimate the intraday pages
+const int MOSCOW_EXCHANGE_INTRADAY_CANDLES = 900;
 
 class MoscowExchangeBackend : public AbstractDataBackend {
     Q_OBJECT
 public:
-    explicit MoscowExchangeBackend(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    explicit MoscowExchangeBackend(NetworkService *networkService, QObject *parent = nullptr);
     ~MoscowExchangeBackend() override;
-    Q_INVOKABLE void searchName(const QString &searchString) override;
-    Q_INVOKABLE void searchQuote(const QString &searchString) override;
-    Q_INVOKABLE void fetchPricesForChart(const QString &extRefId, const int chartType) override;
+    void searchName(const QString &searchString, const int requestId) override;
+    void fetchPricesForChart(const QString &extRefId, const int chartType, const int requestId) override;
+
+    QList<QStringList> splitQuoteBatches(const QStringList &extRefIds) override;
+    QJsonArray parseQuoteBatch(const QByteArray &quoteReply) override;
 
 signals:
 
 protected:
     QString convertCurrency(const QString &currencyString) override;
     QString getLanguage();
+    PendingReply *executeQuoteBatchRequest(const QStringList &extRefIds,
+                                           RequestScheduler::RequestPriority priority) override;
 
 public slots:
 
 private:
     bool debugMode = false;
 
+    // candles of a chart - the pages are requested at the same time and stitched in order when all arrived
+    struct ChartFetch
+    {
+        QString extRefId;
+        int chartType;
+        int interval;
+        QString startDate;
+        // scope of the chart request - pages that are requested later belong to the same scope
+        QString requestTag;
+        int requestId;
+        QVector<ChartSeriesData> pages;
+        int pendingPages;
+    };
+    QHash<int, ChartFetch> chartFetches;
+    int lastChartFetchId = 0;
+
     // is triggered after name search because the first json request does not contain all information we need
-    void searchQuoteForNameSearch(const QString &searchString);
-    QString processSearchResult(QByteArray searchReply);
-    QString processQuoteResult(QByteArray searchReply);
-    QString parsePriceResponse(QByteArray priceReply);
+    void searchQuoteForNameSearch(const QString &searchString, const int requestId);
+    QString processSearchResult(const QByteArray &searchReply);
+    QVariant parseCandlesResponse(const QByteArray &candlesReply, int interval);
+
+    void fetchChartPage(int fetchId, int page);
+    void processChartPage(int fetchId, int page, const QVariant &chartSeriesData);
+    // a page failed, was aborted or its parse job was cancelled - the fetch and its request are dropped
+    void abortChartFetch(int fetchId);
 
 private slots:
     void handleSearchNameFinished();
     void handleSearchQuoteForNameFinished();
-    void handleSearchQuoteFinished();
-    void handleFetchPricesForChartFinished();
 };
 
 #endif // MOSCOWEXCHANGEBACKEND_H
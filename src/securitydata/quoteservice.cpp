@@ -0,0 +1,233 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "quoteservice.h"
+#include "../loggingcategories.h"
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QSet>
+#include <QTimer>
+#include <QVariantMap>
+
+QuoteService::QuoteService(NetworkService *networkService, QObject *parent)
+    : QObject(parent)
+    , networkService(networkService) {
+    qCDebug(lcNetwork) << "Initializing Quote Service...";
+}
+
+QuoteService::~QuoteService() {
+    qCDebug(lcNetwork) << "Shutting down Quote Service...";
+}
+
+void QuoteService::registerBackend(int backendId, AbstractDataBackend *backend) {
+    backends.insert(backendId, backend);
+}
+
+int QuoteService::fetchQuotes(const QVariantList &securities,
+                              const QJSValue &batchCallback,
+                              const QJSValue &completedCallback) {
+    return fetchQuotes(toQuoteRequests(securities), RequestScheduler::INTERACTIVE, batchCallback, completedCallback);
+}
+
+int QuoteService::fetchQuotesInBackground(const QVariantList &securities,
+                                          const QJSValue &batchCallback,
+                                          const QJSValue &completedCallback) {
+    return fetchQuotes(toQuoteRequests(securities), RequestScheduler::BACKGROUND, batchCallback, completedCallback);
+}
+
+int QuoteService::fetchQuotes(const QList<QuoteRequest> &quoteRequests, RequestScheduler::RequestPriority priority) {
+    return fetchQuotes(quoteRequests, priority, QJSValue(), QJSValue());
+}
+
+QList<QuoteRequest> QuoteService::toQuoteRequests(const QVariantList &securities) const {
+    QList<QuoteRequest> quoteRequests;
+    foreach (const QVariant &security, securities) {
+        const QVariantMap securityMap = security.toMap();
+        QuoteRequest quoteRequest;
+        quoteRequest.backendId = securityMap.value(QStringLiteral("backendId"), -1).toInt();
+        quoteRequest.extRefId = securityMap.value(QStringLiteral("extRefId")).toString();
+        quoteRequests.append(quoteRequest);
+    }
+    return quoteRequests;
+}
+
+QHash<int, QStringList> QuoteService::groupByBackend(const QList<QuoteRequest> &quoteRequests) const {
+    QHash<int, QStringList> extRefIds;
+    foreach (const QuoteRequest &quoteRequest, quoteRequests) {
+        if (!backends.contains(quoteRequest.backendId)) {
+            qCWarning(lcNetwork) << "QuoteService - unknown data backend" << quoteRequest.backendId << "for"
+                                 << quoteRequest.extRefId;
+            continue;
+        }
+        QStringList &backendExtRefIds = extRefIds[quoteRequest.backendId];
+        if (!quoteRequest.extRefId.isEmpty() && !backendExtRefIds.contains(quoteRequest.extRefId)) {
+            backendExtRefIds.append(quoteRequest.extRefId);
+        }
+    }
+    return extRefIds;
+}
+
+int QuoteService::fetchQuotes(const QList<QuoteRequest> &quoteRequests,
+                              RequestScheduler::RequestPriority priority,
+                              const QJSValue &batchCallback,
+                              const QJSValue &completedCallback) {
+    const int fetchId = ++lastQuoteFetchId;
+    QuoteFetch &quoteFetch = quoteFetches[fetchId];
+    quoteFetch.openBatches = 0;
+    quoteFetch.batchCallback = batchCallback;
+    quoteFetch.completedCallback = completedCallback;
+    // a qml caller has just called the service - so the service is known to the engine of the caller
+    if (batchCallback.isCallable() || completedCallback.isCallable()) {
+        quoteFetch.engine = qjsEngine(this);
+    }
+
+    // all batches of all backends are requested right away - the scheduler limits the requests per host
+    const QHash<int, QStringList> extRefIds = groupByBackend(quoteRequests);
+    for (auto it = extRefIds.constBegin(); it != extRefIds.constEnd(); ++it) {
+        const int backendId = it.key();
+        AbstractDataBackend *backend = backends.value(backendId);
+
+        foreach (const QStringList &batchExtRefIds, backend->splitQuoteBatches(it.value())) {
+            QuoteBatch quoteBatch;
+            quoteBatch.backendId = backendId;
+            quoteBatch.extRefIds = batchExtRefIds;
+            quoteBatch.failed = false;
+            const int batch = quoteFetch.batches.size();
+            quoteFetch.batches.append(quoteBatch);
+            quoteFetch.openBatches++;
+
+            PendingReply *reply = backend->fetchQuoteBatch(batchExtRefIds, priority);
+            connect(reply, &PendingReply::finished, this, [this, reply, backend, fetchId, batch]() {
+                reply->deleteLater();
+                if (!quoteFetches.contains(fetchId)) {
+                    return;
+                }
+                if (reply->error() == QNetworkReply::OperationCanceledError) {
+                    abortFetch(fetchId);
+                    return;
+                }
+                if (reply->error() != QNetworkReply::NoError) {
+                    // the backend reports the error via requestError
+                    quoteFetches[fetchId].batches[batch].failed = true;
+                    completeBatch(fetchId);
+                    return;
+                }
+                networkService->processInBackground(
+                    reply->readAll(),
+                    [backend](const QByteArray &data) { return QVariant(backend->parseQuoteBatch(data)); },
+                    this,
+                    [this, fetchId, batch](const QVariant &quotes) { processQuoteBatch(fetchId, batch, quotes); },
+                    reply->tag(),
+                    [this, fetchId]() { abortFetch(fetchId); });
+            });
+        }
+    }
+
+    qCDebug(lcNetwork) << "QuoteService::fetchQuotes -" << quoteRequests.size() << "securities in"
+                       << quoteFetch.openBatches << "batches";
+    if (quoteFetch.openBatches == 0) {
+        // the caller needs the request id before the signal arrives - complete on the next event loop iteration
+        quoteFetch.openBatches = 1;
+        QTimer::singleShot(0, this, [this, fetchId]() { completeBatch(fetchId); });
+    }
+    return fetchId;
+}
+
+void QuoteService::abortFetch(int fetchId) {
+    // the page of the caller is gone - neither the quotes of the other batches nor the completion are reported
+    if (quoteFetches.remove(fetchId) > 0) {
+        qCDebug(lcNetwork) << "QuoteService::abortFetch -" << fetchId;
+    }
+}
+
+void QuoteService::processQuoteBatch(int fetchId, int batch, const QVariant &quotes) {
+    if (!quoteFetches.contains(fetchId)) {
+        return;
+    }
+    QuoteFetch &quoteFetch = quoteFetches[fetchId];
+    QuoteBatch &quoteBatch = quoteFetch.batches[batch];
+    QJsonArray batchQuotes;
+    foreach (const QJsonValue &quote, quotes.toJsonArray()) {
+        QuoteResult quoteResult;
+        quoteResult.backendId = quoteBatch.backendId;
+        quoteResult.quote = quote.toObject();
+        // some apis use numeric ids
+        quoteResult.extRefId = quoteResult.quote.value(QStringLiteral("extRefId")).toVariant().toString();
+        quoteBatch.results.append(quoteResult);
+
+        QJsonObject batchQuote = quoteResult.quote;
+        batchQuote.insert(QStringLiteral("backendId"), quoteResult.backendId);
+        batchQuotes.append(batchQuote);
+    }
+
+    // the quotes are shown right away - a slow batch does not delay the others
+    if (!batchQuotes.isEmpty()) {
+        invokeCallback(quoteFetch.engine, quoteFetch.batchCallback, batchQuotes.toVariantList());
+    }
+    // the callback may have started another fetch - the fetch is looked up again
+    completeBatch(fetchId);
+}
+
+void QuoteService::completeBatch(int fetchId) {
+    if (!quoteFetches.contains(fetchId)) {
+        return;
+    }
+    QuoteFetch &quoteFetch = quoteFetches[fetchId];
+    if (--quoteFetch.openBatches > 0) {
+        return;
+    }
+
+    QList<QuoteResult> quoteResults;
+    QJsonArray itemStatus;
+    foreach (const QuoteBatch &quoteBatch, quoteFetch.batches) {
+        QSet<QString> receivedExtRefIds;
+        foreach (const QuoteResult &quoteResult, quoteBatch.results) {
+            receivedExtRefIds.insert(quoteResult.extRefId);
+        }
+        foreach (const QString &extRefId, quoteBatch.extRefIds) {
+            QJsonObject status;
+            status.insert(QStringLiteral("backendId"), quoteBatch.backendId);
+            status.insert(QStringLiteral("extRefId"), extRefId);
+            if (quoteBatch.failed) {
+                status.insert(QStringLiteral("status"), QStringLiteral("error"));
+            } else if (receivedExtRefIds.contains(extRefId)) {
+                status.insert(QStringLiteral("status"), QStringLiteral("ok"));
+            } else {
+                status.insert(QStringLiteral("status"), QStringLiteral("missing"));
+            }
+            itemStatus.append(status);
+        }
+        quoteResults += quoteBatch.results;
+    }
+    const QPointer<QJSEngine> engine = quoteFetch.engine;
+    const QJSValue completedCallback = quoteFetch.completedCallback;
+    quoteFetches.remove(fetchId);
+
+    emit quoteResultsAvailable(fetchId, quoteResults);
+    invokeCallback(engine, completedCallback, itemStatus.toVariantList());
+}
+
+void QuoteService::invokeCallback(QPointer<QJSEngine> engine, QJSValue callback, const QVariantList &values) {
+    if (engine.isNull() || !callback.isCallable()) {
+        return;
+    }
+    const QJSValue result = callback.call(QJSValueList() << engine->toScriptValue(values));
+    if (result.isError()) {
+        qCWarning(lcNetwork) << "QuoteService::invokeCallback -" << result.toString();
+    }
+}
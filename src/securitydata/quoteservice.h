@@ -0,0 +1,127 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef QUOTE_SERVICE_H
+#define QUOTE_SERVICE_H
+
+#include <QHash>
+#include <QJSEngine>
+#include <QJSValue>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+
+#include "abstractdatabackend.h"
+
+struct QuoteRequest
+{
+    // backend ids - see constants.js
+    int backendId;
+    QString extRefId;
+};
+
+struct QuoteResult
+{
+    int backendId;
+    QString extRefId;
+    // the quote in the format of the parseQuoteBatch entries of the backend
+    QJsonObject quote;
+};
+
+/**
+ * Fetches the quotes of securities of any data backend. The ids are split into the batches of each backend
+ * (comma separated id lists that fit into the url, one request per id if the api has no batch lookup),
+ * all batches are requested at the same time and the quotes are merged into one result. The quotes of a
+ * batch are handed to the callback of the qml caller as soon as the batch has arrived, so each page only
+ * gets the quotes it has requested.
+ */
+class QuoteService : public QObject {
+    Q_OBJECT
+public:
+    explicit QuoteService(NetworkService *networkService, QObject *parent = nullptr);
+    ~QuoteService() override;
+
+    void registerBackend(int backendId, AbstractDataBackend *backend);
+
+    // securities are objects with the attributes "backendId" and "extRefId". batchCallback(quotes) gets the quotes
+    // of each batch as a js array, each quote has the attribute "backendId". completedCallback(itemStatus) is called
+    // when all batches have finished with a js array of the "backendId", "extRefId" and "status" ("ok", "error" if
+    // the request failed, "missing" if the response did not contain the security) of each security.
+    // Returns the request id.
+    Q_INVOKABLE int fetchQuotes(const QVariantList &securities,
+                                const QJSValue &batchCallback,
+                                const QJSValue &completedCallback);
+    // same as fetchQuotes, but the requests do not delay the requests of the visible page (e.g. cover refresh)
+    Q_INVOKABLE int fetchQuotesInBackground(const QVariantList &securities,
+                                            const QJSValue &batchCallback,
+                                            const QJSValue &completedCallback);
+    // the quotes are passed to quoteResultsAvailable - returns the request id
+    int fetchQuotes(const QList<QuoteRequest> &quoteRequests, RequestScheduler::RequestPriority priority);
+
+    // distinct ids per backend in the order of the requests - requests of unknown backends are dropped
+    QHash<int, QStringList> groupByBackend(const QList<QuoteRequest> &quoteRequests) const;
+
+signals:
+    // quotes of all batches of a fetch - the quotes of failed batches are missing
+    void quoteResultsAvailable(int requestId, const QList<QuoteResult> &quoteResults);
+
+private:
+    struct QuoteBatch
+    {
+        int backendId;
+        QStringList extRefIds;
+        QList<QuoteResult> results;
+        bool failed;
+    };
+
+    // the quotes are stored per batch - the result keeps the order of the batches, not the order of the replies
+    struct QuoteFetch
+    {
+        QVector<QuoteBatch> batches;
+        int openBatches;
+        // callbacks of a qml caller and the engine they belong to
+        QJSValue batchCallback;
+        QJSValue completedCallback;
+        QPointer<QJSEngine> engine;
+    };
+
+    NetworkService *networkService;
+    QHash<int, AbstractDataBackend *> backends;
+    QHash<int, QuoteFetch> quoteFetches;
+    int lastQuoteFetchId = 0;
+
+    QList<QuoteRequest> toQuoteRequests(const QVariantList &securities) const;
+    int fetchQuotes(const QList<QuoteRequest> &quoteRequests,
+                    RequestScheduler::RequestPriority priority,
+                    const QJSValue &batchCallback,
+                    const QJSValue &completedCallback);
+    void invokeCallback(QPointer<QJSEngine> engine, QJSValue callback, const QVariantList &values);
+    // a batch was aborted or its parse job cancelled with the request scope of the caller - the fetch is dropped
+    void abortFetch(int fetchId);
+    void processQuoteBatch(int fetchId, int batch, const QVariant &quotes);
+    void completeBatch(int fetchId);
+
+#ifdef UNIT_TEST
+    friend class SecurityDataTests;
+#endif
+};
+
+#endif // QUOTE_SERVICE_H
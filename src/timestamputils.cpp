@@ -0,0 +1,264 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "timestamputils.h"
+
+#include <QHash>
+#include <QMutexLocker>
+
+#include <limits>
+
+namespace {
+const qint64 MSECS_PER_DAY = 86400000;
+
+int digitAt(const QChar *data, int position) {
+    const ushort c = data[position].unicode();
+    return (c >= '0' && c <= '9') ? (c - '0') : -1;
+}
+
+bool readNumber(const QChar *data, int length, int &position, int digits, int &value) {
+    if (position + digits > length) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < digits; i++) {
+        const int digit = digitAt(data, position + i);
+        if (digit < 0) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    position += digits;
+    return true;
+}
+
+bool readCharacter(const QChar *data, int length, int &position, char character) {
+    if (position < length && data[position] == QLatin1Char(character)) {
+        position++;
+        return true;
+    }
+    return false;
+}
+
+bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int daysInMonth(int year, int month) {
+    static const int DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (month == 2 && isLeapYear(year)) ? 29 : DAYS_IN_MONTH[month - 1];
+}
+
+// days since 1970-01-01 of a date of the gregorian calendar
+qint64 daysSinceEpoch(int year, int month, int day) {
+    year -= (month <= 2) ? 1 : 0;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yearOfEra = year - era * 400;
+    const int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return static_cast<qint64>(era) * 146097 + dayOfEra - 719468;
+}
+} // namespace
+
+TimeZoneOffsetCache::TimeZoneOffsetCache(const QTimeZone &timeZone)
+    : timeZone(timeZone) {
+}
+
+int TimeZoneOffsetCache::offsetFromUtc(qint64 utcMSecs) {
+    QMutexLocker locker(&mutex);
+    // the timestamps of a chart are ordered - the period of the previous timestamp matches most of the time
+    if (lastPeriodIndex >= 0) {
+        const Period &lastPeriod = periods.at(lastPeriodIndex);
+        if (utcMSecs >= lastPeriod.startMSecs && utcMSecs < lastPeriod.endMSecs) {
+            return lastPeriod.offsetSeconds;
+        }
+    }
+    for (int i = 0; i < periods.size(); i++) {
+        if (utcMSecs >= periods.at(i).startMSecs && utcMSecs < periods.at(i).endMSecs) {
+            lastPeriodIndex = i;
+            return periods.at(i).offsetSeconds;
+        }
+    }
+    periods.append(lookupPeriod(utcMSecs));
+    lastPeriodIndex = periods.size() - 1;
+    return periods.last().offsetSeconds;
+}
+
+qint64 TimeZoneOffsetCache::wallTimeToUtc(qint64 wallMSecs) {
+    // the offset at the wall time is a good guess - the second lookup corrects it close to a transition
+    const qint64 guessedUtcMSecs = wallMSecs - offsetFromUtc(wallMSecs) * 1000LL;
+    return wallMSecs - offsetFromUtc(guessedUtcMSecs) * 1000LL;
+}
+
+TimeZoneOffsetCache::Period TimeZoneOffsetCache::lookupPeriod(qint64 utcMSecs) const {
+    const QDateTime utcDateTime = QDateTime::fromMSecsSinceEpoch(utcMSecs, Qt::UTC);
+    Period period;
+    period.offsetSeconds = timeZone.offsetFromUtc(utcDateTime);
+    period.startMSecs = std::numeric_limits<qint64>::min();
+    period.endMSecs = std::numeric_limits<qint64>::max();
+
+    if (timeZone.hasTransitions()) {
+        const QTimeZone::OffsetData previousTransition = timeZone.previousTransition(utcDateTime);
+        const QTimeZone::OffsetData nextTransition = timeZone.nextTransition(utcDateTime);
+        if (previousTransition.atUtc.isValid()) {
+            // a transition exactly at the timestamp is not returned as previous transition
+            period.startMSecs = (previousTransition.offsetFromUtc == period.offsetSeconds)
+                                    ? previousTransition.atUtc.toMSecsSinceEpoch()
+                                    : utcMSecs;
+        }
+        if (nextTransition.atUtc.isValid()) {
+            period.endMSecs = nextTransition.atUtc.toMSecsSinceEpoch();
+        }
+    }
+    return period;
+}
+
+TimeZoneOffsetCache &TimeZoneOffsetCache::local() {
+    static TimeZoneOffsetCache localTimeZoneCache(QTimeZone::systemTimeZone());
+    return localTimeZoneCache;
+}
+
+TimeZoneOffsetCache &TimeZoneOffsetCache::forTimeZone(const QTimeZone &timeZone) {
+    static QMutex cachesMutex;
+    // only a few time zones are used - the caches are kept until the application exits
+    static QHash<QByteArray, TimeZoneOffsetCache *> caches;
+
+    QMutexLocker locker(&cachesMutex);
+    TimeZoneOffsetCache *cache = caches.value(timeZone.id());
+    if (!cache) {
+        cache = new TimeZoneOffsetCache(timeZone);
+        caches.insert(timeZone.id(), cache);
+    }
+    return *cache;
+}
+
+bool TimestampUtils::parseIsoDateTime(const QString &text, qint64 &wallMSecs, int &offsetSeconds) {
+    const QChar *data = text.constData();
+    const int length = text.length();
+    int position = 0;
+
+    int year, month, day;
+    if (!readNumber(data, length, position, 4, year) || !readCharacter(data, length, position, '-')
+        || !readNumber(data, length, position, 2, month) || !readCharacter(data, length, position, '-')
+        || !readNumber(data, length, position, 2, day)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+
+    int hour = 0, minute = 0, second = 0, msec = 0;
+    offsetSeconds = 0;
+    if (readCharacter(data, length, position, 'T') || readCharacter(data, length, position, ' ')) {
+        if (!readNumber(data, length, position, 2, hour) || !readCharacter(data, length, position, ':')
+            || !readNumber(data, length, position, 2, minute)) {
+            return false;
+        }
+        if (readCharacter(data, length, position, ':')) {
+            if (!readNumber(data, length, position, 2, second)) {
+                return false;
+            }
+            if (readCharacter(data, length, position, '.') || readCharacter(data, length, position, ',')) {
+                // only milliseconds are kept - further digits are skipped
+                int fractionDigits = 0;
+                for (int scale = 100; position < length && digitAt(data, position) >= 0; position++) {
+                    msec += digitAt(data, position) * scale;
+                    scale /= 10;
+                    fractionDigits++;
+                }
+                if (fractionDigits == 0) {
+                    return false;
+                }
+            }
+        }
+        if (hour > 23 || minute > 59 || second > 59) {
+            return false;
+        }
+
+        if (!readCharacter(data, length, position, 'Z') && position < length) {
+            int sign = 0;
+            if (readCharacter(data, length, position, '+')) {
+                sign = 1;
+            } else if (readCharacter(data, length, position, '-')) {
+                sign = -1;
+            }
+            int offsetHours = 0, offsetMinutes = 0;
+            if (sign == 0 || !readNumber(data, length, position, 2, offsetHours)) {
+                return false;
+            }
+            readCharacter(data, length, position, ':');
+            if (position < length && !readNumber(data, length, position, 2, offsetMinutes)) {
+                return false;
+            }
+            offsetSeconds = sign * (offsetHours * 3600 + offsetMinutes * 60);
+        }
+    }
+
+    if (position != length) {
+        return false;
+    }
+
+    wallMSecs = daysSinceEpoch(year, month, day) * MSECS_PER_DAY + ((hour * 60 + minute) * 60 + second) * 1000LL + msec;
+    return true;
+}
+
+bool TimestampUtils::parseWallTime(const QString &text, qint64 &wallMSecs) {
+    int offsetSeconds;
+    if (parseIsoDateTime(text, wallMSecs, offsetSeconds)) {
+        return true;
+    }
+    // formats that are not covered by the fast path
+    const QDateTime dateTime = QDateTime::fromString(text, Qt::ISODate);
+    if (!dateTime.isValid()) {
+        return false;
+    }
+    wallMSecs = QDateTime(dateTime.date(), dateTime.time(), Qt::UTC).toMSecsSinceEpoch();
+    return true;
+}
+
+qint64 TimestampUtils::utcTimestampToMSecs(const QString &utcDateTimeString) {
+    qint64 wallMSecs;
+    return parseWallTime(utcDateTimeString, wallMSecs) ? wallMSecs : 0;
+}
+
+QDateTime TimestampUtils::convertUtcToLocalDateTime(const QString &utcDateTimeString) {
+    qint64 wallMSecs;
+    if (!parseWallTime(utcDateTimeString, wallMSecs)) {
+        return QDateTime();
+    }
+    return toLocalDateTime(wallMSecs);
+}
+
+QDateTime TimestampUtils::convertToLocalDateTime(const QString &dateTimeString, TimeZoneOffsetCache &timeZoneCache) {
+    qint64 wallMSecs;
+    if (!parseWallTime(dateTimeString, wallMSecs)) {
+        return QDateTime();
+    }
+    return toLocalDateTime(timeZoneCache.wallTimeToUtc(wallMSecs));
+}
+
+qint64 TimestampUtils::localDateTimeToMSecs(const QString &dateString, int secondsOfDay) {
+    qint64 wallMSecs;
+    if (!parseWallTime(dateString, wallMSecs)) {
+        return 0;
+    }
+    return TimeZoneOffsetCache::local().wallTimeToUtc(wallMSecs + secondsOfDay * 1000LL);
+}
+
+QDateTime TimestampUtils::toLocalDateTime(qint64 utcMSecs) {
+    return QDateTime::fromMSecsSinceEpoch(utcMSecs, Qt::OffsetFromUTC, TimeZoneOffsetCache::local().offsetFromUtc(utcMSecs));
+}
@@ -0,0 +1,87 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef TIMESTAMP_UTILS_H
+#define TIMESTAMP_UTILS_H
+
+#include <QDateTime>
+#include <QMutex>
+#include <QString>
+#include <QTimeZone>
+#include <QVector>
+
+/**
+ * Caches the offsets of a time zone. Each lookup of the time zone database stores the offset for the whole
+ * period between the surrounding transitions (e.g. summer time), so the following timestamps are resolved
+ * without asking QTimeZone again. The cache can be used from multiple threads.
+ */
+class TimeZoneOffsetCache {
+public:
+    explicit TimeZoneOffsetCache(const QTimeZone &timeZone);
+
+    int offsetFromUtc(qint64 utcMSecs);
+    // wall clock time (msecs since epoch as if it was utc) of the time zone to utc
+    qint64 wallTimeToUtc(qint64 wallMSecs);
+
+    // cache of the system time zone - the zone is determined once per application run
+    static TimeZoneOffsetCache &local();
+    static TimeZoneOffsetCache &forTimeZone(const QTimeZone &timeZone);
+
+private:
+    struct Period
+    {
+        qint64 startMSecs;
+        qint64 endMSecs;
+        int offsetSeconds;
+    };
+
+    const QTimeZone timeZone;
+    QVector<Period> periods;
+    int lastPeriodIndex = -1;
+    QMutex mutex;
+
+    Period lookupPeriod(qint64 utcMSecs) const;
+};
+
+/**
+ * Conversion of the timestamps of the data backends.
+ */
+class TimestampUtils {
+public:
+    /**
+     * Parses "yyyy-MM-dd" and "yyyy-MM-ddThh:mm[:ss[.zzz]]" with an optional "Z", "+hh:mm" or "+hhmm" designator.
+     * The date and the time may also be separated by a space. wallMSecs is the date and time as msecs since epoch,
+     * ignoring the designator - the designator is returned in offsetSeconds.
+     */
+    static bool parseIsoDateTime(const QString &text, qint64 &wallMSecs, int &offsetSeconds);
+
+    // the designator of the utc timestamp is ignored - returns 0 if the timestamp cannot be parsed
+    static qint64 utcTimestampToMSecs(const QString &utcDateTimeString);
+    static QDateTime convertUtcToLocalDateTime(const QString &utcDateTimeString);
+    // the timestamp is the wall clock time of the time zone
+    static QDateTime convertToLocalDateTime(const QString &dateTimeString, TimeZoneOffsetCache &timeZoneCache);
+    // date and time of the local time zone to msecs since epoch
+    static qint64 localDateTimeToMSecs(const QString &dateString, int secondsOfDay);
+
+    // the returned date time has a fixed offset - formatting it does not require another time zone lookup
+    static QDateTime toLocalDateTime(qint64 utcMSecs);
+
+private:
+    static bool parseWallTime(const QString &text, qint64 &wallMSecs);
+};
+
+#endif // TIMESTAMP_UTILS_H
@@ -16,22 +16,39 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "watchlist.h"
+#include "loggingcategories.h"
+#include "constants.h"
+#include "network/responsecache.h"
+
+#include <QUrl>
+
+// an open connection is not opened again within this time
+const int PRECONNECT_INTERVAL_SECONDS = 60;
 
 Watchlist::Watchlist(QObject *parent)
     : QObject(parent)
     , networkAccessManager(new QNetworkAccessManager(this))
     , networkConfigurationManager(new QNetworkConfigurationManager(this))
+    , networkService(new NetworkService(networkAccessManager, this))
     , settings("harbour-watchlist", "settings") {
+    // the network access manager takes ownership of the cache
+    networkAccessManager->setCache(new ResponseCache(networkAccessManager));
+
     // data backends
-    euroinvestorBackend = new EuroinvestorBackend(this->networkAccessManager, this);
-    moscowExchangeBackend = new MoscowExchangeBackend(this->networkAccessManager, this);
-    ingDibaBackend = new IngDibaBackend(this->networkAccessManager, this);
+    euroinvestorBackend = new EuroinvestorBackend(this->networkService, this);
+    moscowExchangeBackend = new MoscowExchangeBackend(this->networkService, this);
+    ingDibaBackend = new IngDibaBackend(this->networkService, this);
+    // backend ids - see constants.js
+    quoteService = new QuoteService(this->networkService, this);
+    quoteService->registerBackend(0, euroinvestorBackend);
+    quoteService->registerBackend(1, moscowExchangeBackend);
+    quoteService->registerBackend(2, ingDibaBackend);
     // market data backends
-    euroinvestorMarketDataBackend = new EuroinvestorMarketDataBackend(this->networkAccessManager, this);
+    euroinvestorMarketDataBackend = new EuroinvestorMarketDataBackend(this->networkService, this);
     // news backends
-    onvistaNews = new OnvistaNews(this->networkAccessManager, this);
-    ingDibaNews = new IngDibaNews(this->networkAccessManager, this);
-    divvyDiaryBackend = new DivvyDiary(this->networkAccessManager, this);
+    onvistaNews = new OnvistaNews(this->networkService, this);
+    ingDibaNews = new IngDibaNews(this->networkService, this);
+    divvyDiaryBackend = new DivvyDiary(this->networkService, this);
 }
 
 bool Watchlist::isWiFi() {
@@ -42,14 +59,45 @@ bool Watchlist::isWiFi() {
         QNetworkConfiguration activeConfiguration = configurationIterator.next();
         if (activeConfiguration.bearerType() == QNetworkConfiguration::BearerWLAN
             || activeConfiguration.bearerType() == QNetworkConfiguration::BearerEthernet) {
-            qDebug() << "Watchlist::isWiFi : WiFi ON!";
+            qCDebug(lcNetwork) << "Watchlist::isWiFi : WiFi ON!";
             return true;
         }
     }
-    qDebug() << "Watchlist::isWiFi : WiFi OFF!";
+    qCDebug(lcNetwork) << "Watchlist::isWiFi : WiFi OFF!";
     return false;
 }
 
+void Watchlist::preconnect(int dataBackend) {
+    // backend ids - see constants.js
+    QStringList hosts;
+    switch (dataBackend) {
+    case 0:
+        hosts << QUrl(EUROINVESTOR_API_QUOTE).host();
+        break;
+    case 1:
+        hosts << QUrl(MOSCOW_EXCHANGE_QUOTE).host();
+        break;
+    case 2:
+        hosts << QUrl(ING_DIBA_API_QUOTE).host();
+        break;
+    default:
+        qCDebug(lcNetwork) << "Watchlist::preconnect - unknown data backend " << dataBackend;
+        return;
+    }
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    foreach (const QString &host, hosts) {
+        if (preconnectTimes.contains(host) && preconnectTimes.value(host).secsTo(now) < PRECONNECT_INTERVAL_SECONDS) {
+            continue;
+        }
+        qCDebug(lcNetwork) << "Watchlist::preconnect - " << host;
+        preconnectTimes.insert(host, now);
+        // resolves the host name and performs the tcp and tls handshake - later requests reuse the connection
+        networkAccessManager->connectToHostEncrypted(host, 443, networkService->sslConfigurationForHost(host));
+        networkService->registerPreconnectedHost(host);
+    }
+}
+
 EuroinvestorBackend *Watchlist::getEuroinvestorBackend() {
     return this->euroinvestorBackend;
 }
@@ -62,6 +110,10 @@ IngDibaBackend *Watchlist::getIngDibaBackend() {
     return this->ingDibaBackend;
 }
 
+QuoteService *Watchlist::getQuoteService() {
+    return this->quoteService;
+}
+
 OnvistaNews *Watchlist::getOnvistaNews() {
     return this->onvistaNews;
 }
@@ -77,3 +129,7 @@ EuroinvestorMarketDataBackend *Watchlist::getEuroinvestorMarketDataBackend() {
 DivvyDiary *Watchlist::getDivvyDiaryBackend() {
     return this->divvyDiaryBackend;
 }
+
+NetworkService *Watchlist::getNetworkService() {
+    return this->networkService;
+}
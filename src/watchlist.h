@@ -18,6 +18,8 @@
 #ifndef WATCHLIST_H
 #define WATCHLIST_H
 
+#include <QDateTime>
+#include <QHash>
 #include <QNetworkAccessManager>
 #include <QNetworkConfigurationManager>
 #include <QObject>
@@ -29,7 +31,9 @@
 #include "securitydata/euroinvestorbackend.h"
 #include "securitydata/ingdibabackend.h"
 #include "securitydata/moscowexchangebackend.h"
+#include "securitydata/quoteservice.h"
 #include "dividenddata/divvydiary.h"
+#include "network/networkservice.h"
 
 class Watchlist : public QObject {
     Q_OBJECT
@@ -40,11 +44,15 @@ public:
     MoscowExchangeBackend *getMoscowExchangeBackend();
     EuroinvestorMarketDataBackend *getEuroinvestorMarketDataBackend();
     IngDibaBackend *getIngDibaBackend();
+    QuoteService *getQuoteService();
     OnvistaNews *getOnvistaNews();
     IngDibaNews *getIngDibaNews();
     DivvyDiary *getDivvyDiaryBackend();
+    NetworkService *getNetworkService();
 
     Q_INVOKABLE bool isWiFi();
+    // opens the connections to the hosts of the data backend before the first request needs them
+    Q_INVOKABLE void preconnect(int dataBackend);
 
 signals:
 
@@ -53,11 +61,14 @@ public slots:
 private:
     QNetworkAccessManager *const networkAccessManager;
     QNetworkConfigurationManager *const networkConfigurationManager;
+    NetworkService *const networkService;
 
     // data backends
     EuroinvestorBackend *euroinvestorBackend;
     MoscowExchangeBackend *moscowExchangeBackend;
     IngDibaBackend *ingDibaBackend;
+    // quotes of all data backends
+    QuoteService *quoteService;
 
     // market data backends
     EuroinvestorMarketDataBackend *euroinvestorMarketDataBackend;
@@ -70,6 +81,9 @@ private:
     DivvyDiary *divvyDiaryBackend;
 
     QSettings settings;
+
+    // time of the last preconnect per host - idle connections are kept open by the network access manager
+    QHash<QString, QDateTime> preconnectTimes;
 };
 
 #endif // WATCHLIST_H
@@ -0,0 +1,246 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "watchlistmodel.h"
+#include "../loggingcategories.h"
+
+#include <QDebug>
+#include <QSet>
+
+#include <math.h>
+
+namespace {
+// the order defines the role numbers - append new attributes at the end
+const char *const SECURITY_KEYS[] = {"id",
+                                     "watchlistId",
+                                     "extRefId",
+                                     "name",
+                                     "currency",
+                                     "currencySymbol",
+                                     "stockMarketSymbol",
+                                     "stockMarketName",
+                                     "isin",
+                                     "symbol1",
+                                     "symbol2",
+                                     "ask",
+                                     "bid",
+                                     "high",
+                                     "low",
+                                     "volume",
+                                     "price",
+                                     "changeAbsolute",
+                                     "changeRelative",
+                                     "quoteTimestamp",
+                                     "lastChangeTimestamp",
+                                     "notes",
+                                     "referencePrice",
+                                     "pieces",
+                                     "performanceRelative",
+                                     "positionCostValue",
+                                     "positionCurrentValue",
+                                     "portfolioShare"};
+const int SECURITY_KEY_COUNT = sizeof(SECURITY_KEYS) / sizeof(SECURITY_KEYS[0]);
+const int FIRST_SECURITY_ROLE = Qt::UserRole + 1;
+// changes on every refresh but is not displayed - no reason to update a delegate
+const char *const LAST_CHANGE_TIMESTAMP_KEY = "lastChangeTimestamp";
+} // namespace
+
+WatchlistModel::WatchlistModel(QObject *parent)
+    : QAbstractListModel(parent) {
+}
+
+WatchlistModel::~WatchlistModel() {
+}
+
+int WatchlistModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : rows.size();
+}
+
+QVariant WatchlistModel::data(const QModelIndex &index, int role) const {
+    const int keyIndex = role - FIRST_SECURITY_ROLE;
+    if (!index.isValid() || index.row() >= rows.size() || keyIndex < 0 || keyIndex >= SECURITY_KEY_COUNT) {
+        return QVariant();
+    }
+    return rows.at(index.row()).value(SECURITY_KEYS[keyIndex]);
+}
+
+QHash<int, QByteArray> WatchlistModel::roleNames() const {
+    QHash<int, QByteArray> roles;
+    for (int i = 0; i < SECURITY_KEY_COUNT; i++) {
+        roles.insert(FIRST_SECURITY_ROLE + i, SECURITY_KEYS[i]);
+    }
+    return roles;
+}
+
+int WatchlistModel::roleForKey(const QString &key) const {
+    for (int i = 0; i < SECURITY_KEY_COUNT; i++) {
+        if (key == SECURITY_KEYS[i]) {
+            return FIRST_SECURITY_ROLE + i;
+        }
+    }
+    return -1;
+}
+
+void WatchlistModel::update(const QVariantList &securities) {
+    qCDebug(lcDb) << "WatchlistModel::update - rows :" << rows.size() << ", securities :" << securities.size();
+    const int previousCount = rows.size();
+
+    double depotCurrentValue = 0.0;
+    foreach (const QVariant &security, securities) {
+        depotCurrentValue += security.toMap().value("positionCurrentValue").toDouble();
+    }
+
+    QList<int> securityIds;
+    QHash<int, QVariantMap> securitiesById;
+    foreach (const QVariant &security, securities) {
+        QVariantMap securityMap = security.toMap();
+        const double positionCurrentValue = securityMap.value("positionCurrentValue").toDouble();
+        const bool hasPosition = (positionCurrentValue != 0.0 && depotCurrentValue != 0.0);
+        securityMap.insert("portfolioShare", hasPosition ? (positionCurrentValue * 100.0 / depotCurrentValue) : 0.0);
+
+        const int securityId = securityMap.value("id").toInt();
+        securityIds.append(securityId);
+        securitiesById.insert(securityId, securityMap);
+    }
+
+    // securities removed from the watchlist
+    for (int row = rows.size() - 1; row >= 0; row--) {
+        if (!securitiesById.contains(rows.at(row).value("id").toInt())) {
+            beginRemoveRows(QModelIndex(), row, row);
+            rows.removeAt(row);
+            endRemoveRows();
+        }
+    }
+
+    // securities already displayed - only rows with changed values are signalled
+    QSet<int> knownSecurityIds;
+    for (int row = 0; row < rows.size(); row++) {
+        const int securityId = rows.at(row).value("id").toInt();
+        knownSecurityIds.insert(securityId);
+        const QVector<int> changedRoles = applyChanges(rows[row], securitiesById.value(securityId));
+        if (!changedRoles.isEmpty()) {
+            emit dataChanged(index(row), index(row), changedRoles);
+        }
+    }
+
+    // securities added to the watchlist
+    QList<QVariantMap> addedRows;
+    foreach (int securityId, securityIds) {
+        if (!knownSecurityIds.contains(securityId)) {
+            knownSecurityIds.insert(securityId);
+            addedRows.append(securitiesById.value(securityId));
+        }
+    }
+    if (!addedRows.isEmpty()) {
+        beginInsertRows(QModelIndex(), rows.size(), rows.size() + addedRows.size() - 1);
+        rows.append(addedRows);
+        endInsertRows();
+    }
+
+    updateMaxChange();
+    if (rows.size() != previousCount) {
+        emit countChanged();
+    }
+}
+
+void WatchlistModel::updateQuotes(const QVariantList &quotes) {
+    qCDebug(lcDb) << "WatchlistModel::updateQuotes - rows :" << rows.size() << ", quotes :" << quotes.size();
+    QHash<QString, int> rowsByExtRefId;
+    for (int row = 0; row < rows.size(); row++) {
+        rowsByExtRefId.insert(rows.at(row).value("extRefId").toString(), row);
+    }
+
+    foreach (const QVariant &quote, quotes) {
+        const QVariantMap quoteMap = quote.toMap();
+        const int row = rowsByExtRefId.value(quoteMap.value("extRefId").toString(), -1);
+        if (row < 0) {
+            continue;
+        }
+        // only the attributes of the rows - the ids of the row are kept
+        QVariantMap values;
+        QVariantMap::const_iterator it;
+        for (it = quoteMap.constBegin(); it != quoteMap.constEnd(); ++it) {
+            if (roleForKey(it.key()) >= 0 && it.key() != QLatin1String("id")
+                && it.key() != QLatin1String("watchlistId")) {
+                values.insert(it.key(), it.value());
+            }
+        }
+        const QVector<int> changedRoles = applyChanges(rows[row], values);
+        if (!changedRoles.isEmpty()) {
+            emit dataChanged(index(row), index(row), changedRoles);
+        }
+    }
+
+    updateMaxChange();
+}
+
+QVariantMap WatchlistModel::get(int row) const {
+    if (row < 0 || row >= rows.size()) {
+        return QVariantMap();
+    }
+    return rows.at(row);
+}
+
+void WatchlistModel::setValue(int securityId, const QString &key, const QVariant &value) {
+    const int row = findRow(securityId);
+    const int role = roleForKey(key);
+    if (row < 0 || role < 0 || rows.at(row).value(key) == value) {
+        return;
+    }
+    rows[row].insert(key, value);
+    emit dataChanged(index(row), index(row), QVector<int>() << role);
+}
+
+double WatchlistModel::getMaxChange() const {
+    return maxChange;
+}
+
+int WatchlistModel::findRow(int securityId) const {
+    for (int row = 0; row < rows.size(); row++) {
+        if (rows.at(row).value("id").toInt() == securityId) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+QVector<int> WatchlistModel::applyChanges(QVariantMap &row, const QVariantMap &security) const {
+    QVector<int> changedRoles;
+    QVariantMap::const_iterator it;
+    for (it = security.constBegin(); it != security.constEnd(); ++it) {
+        if (row.value(it.key()) == it.value()) {
+            continue;
+        }
+        row.insert(it.key(), it.value());
+        const int role = roleForKey(it.key());
+        if (role >= 0 && it.key() != LAST_CHANGE_TIMESTAMP_KEY) {
+            changedRoles.append(role);
+        }
+    }
+    return changedRoles;
+}
+
+void WatchlistModel::updateMaxChange() {
+    double newMaxChange = 0.0;
+    foreach (const QVariantMap &row, rows) {
+        newMaxChange = qMax(newMaxChange, fabs(row.value("changeRelative").toDouble()));
+    }
+    if (newMaxChange != maxChange) {
+        maxChange = newMaxChange;
+        emit maxChangeChanged();
+    }
+}
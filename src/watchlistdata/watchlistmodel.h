@@ -0,0 +1,69 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef WATCHLIST_MODEL_H
+#define WATCHLIST_MODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QVariantMap>
+
+/**
+ * Securities of a watchlist. The rows are updated with the securities loaded from the database - existing rows
+ * are matched by their id, so the delegates are kept and only the values that really changed are signalled.
+ * The role names are the attribute names of the securities, e.g. name, price or changeRelative.
+ */
+class WatchlistModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(double maxChange READ getMaxChange NOTIFY maxChangeChanged)
+public:
+    explicit WatchlistModel(QObject *parent = nullptr);
+    ~WatchlistModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // applies the securities as a diff - rows of securities not contained in the list are removed
+    Q_INVOKABLE void update(const QVariantList &securities);
+    Q_INVOKABLE QVariantMap get(int row) const;
+    // applies the quotes of a quote request to the rows with the same extRefId - other rows are kept
+    Q_INVOKABLE void updateQuotes(const QVariantList &quotes);
+    // updates a single attribute of a security (e.g. notes or reference price changed in a dialog)
+    Q_INVOKABLE void setValue(int securityId, const QString &key, const QVariant &value);
+
+    // largest absolute relative change - used to scale the change bars
+    double getMaxChange() const;
+    int roleForKey(const QString &key) const;
+
+signals:
+    void countChanged();
+    void maxChangeChanged();
+
+private:
+    QList<QVariantMap> rows;
+    double maxChange = 0.0;
+
+    int findRow(int securityId) const;
+    QVector<int> applyChanges(QVariantMap &row, const QVariantMap &security) const;
+    void updateMaxChange();
+};
+
+#endif // WATCHLIST_MODEL_H
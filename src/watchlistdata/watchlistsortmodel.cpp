@@ -0,0 +1,91 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "watchlistsortmodel.h"
+#include "../loggingcategories.h"
+
+#include <QDebug>
+
+WatchlistSortModel::WatchlistSortModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+    , watchlistModel(new WatchlistModel(this)) {
+    nameRole = watchlistModel->roleForKey("name");
+    changeRelativeRole = watchlistModel->roleForKey("changeRelative");
+
+    connect(watchlistModel, SIGNAL(countChanged()), this, SIGNAL(countChanged()));
+    connect(watchlistModel, SIGNAL(maxChangeChanged()), this, SIGNAL(maxChangeChanged()));
+
+    setSourceModel(watchlistModel);
+    // rows are moved when the sort role changes
+    setDynamicSortFilter(true);
+    setSortRole(changeRelativeRole);
+    sort(0);
+}
+
+WatchlistSortModel::~WatchlistSortModel() {
+}
+
+void WatchlistSortModel::update(const QVariantList &securities) {
+    watchlistModel->update(securities);
+}
+
+void WatchlistSortModel::updateQuotes(const QVariantList &quotes) {
+    watchlistModel->updateQuotes(quotes);
+}
+
+QVariantMap WatchlistSortModel::get(int row) const {
+    return watchlistModel->get(mapToSource(index(row, 0)).row());
+}
+
+void WatchlistSortModel::setValue(int securityId, const QString &key, const QVariant &value) {
+    watchlistModel->setValue(securityId, key, value);
+}
+
+int WatchlistSortModel::getSortOrder() const {
+    return sortOrder;
+}
+
+void WatchlistSortModel::setSortOrder(int sortOrder) {
+    if (this->sortOrder == sortOrder) {
+        return;
+    }
+    qCDebug(lcDb) << "WatchlistSortModel::setSortOrder" << sortOrder;
+    this->sortOrder = static_cast<SortOrder>(sortOrder);
+    setSortRole(this->sortOrder == SORT_BY_NAME_ASC ? nameRole : changeRelativeRole);
+    invalidate();
+    emit sortOrderChanged();
+}
+
+int WatchlistSortModel::getCount() const {
+    return watchlistModel->rowCount();
+}
+
+double WatchlistSortModel::getMaxChange() const {
+    return watchlistModel->getMaxChange();
+}
+
+bool WatchlistSortModel::lessThan(const QModelIndex &left, const QModelIndex &right) const {
+    if (sortOrder != SORT_BY_NAME_ASC) {
+        // same order as the database queries - equal changes are sorted by name
+        const double leftChange = left.data(changeRelativeRole).toDouble();
+        const double rightChange = right.data(changeRelativeRole).toDouble();
+        if (leftChange != rightChange) {
+            return (sortOrder == SORT_BY_CHANGE_ASC) ? (leftChange < rightChange) : (leftChange > rightChange);
+        }
+    }
+    return QString::localeAwareCompare(left.data(nameRole).toString(), right.data(nameRole).toString()) < 0;
+}
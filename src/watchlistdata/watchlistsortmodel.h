@@ -0,0 +1,68 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef WATCHLIST_SORT_MODEL_H
+#define WATCHLIST_SORT_MODEL_H
+
+#include <QSortFilterProxyModel>
+
+#include "watchlistmodel.h"
+
+/**
+ * Sorted view of a WatchlistModel that is used by the watchlist page. Changed prices move the rows
+ * to their new position, the delegates are not recreated.
+ */
+class WatchlistSortModel : public QSortFilterProxyModel {
+    Q_OBJECT
+    Q_PROPERTY(int sortOrder READ getSortOrder WRITE setSortOrder NOTIFY sortOrderChanged)
+    Q_PROPERTY(int count READ getCount NOTIFY countChanged)
+    Q_PROPERTY(double maxChange READ getMaxChange NOTIFY maxChangeChanged)
+public:
+    // the first two values are the same as the sorting order constants in constants.js
+    enum SortOrder { SORT_BY_CHANGE_DESC = 0, SORT_BY_NAME_ASC = 1, SORT_BY_CHANGE_ASC = 2 };
+    Q_ENUM(SortOrder)
+
+    explicit WatchlistSortModel(QObject *parent = nullptr);
+    ~WatchlistSortModel() override;
+
+    Q_INVOKABLE void update(const QVariantList &securities);
+    Q_INVOKABLE void updateQuotes(const QVariantList &quotes);
+    // row of the sorted model
+    Q_INVOKABLE QVariantMap get(int row) const;
+    Q_INVOKABLE void setValue(int securityId, const QString &key, const QVariant &value);
+
+    int getSortOrder() const;
+    void setSortOrder(int sortOrder);
+    int getCount() const;
+    double getMaxChange() const;
+
+signals:
+    void sortOrderChanged();
+    void countChanged();
+    void maxChangeChanged();
+
+protected:
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+private:
+    WatchlistModel *const watchlistModel;
+    SortOrder sortOrder = SORT_BY_CHANGE_DESC;
+    int nameRole;
+    int changeRelativeRole;
+};
+
+#endif // WATCHLIST_SORT_MODEL_H
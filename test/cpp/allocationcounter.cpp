@@ -0,0 +1,69 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "allocationcounter.h"
+
+#include <cstdlib>
+
+namespace {
+
+// plain thread local counter - it is read and written from within malloc, so it must not allocate itself
+thread_local qint64 threadAllocations = 0;
+
+} // namespace
+
+#ifdef __GLIBC__
+
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+
+void *malloc(size_t size) __THROW {
+    threadAllocations++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) __THROW {
+    threadAllocations++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) __THROW {
+    threadAllocations++;
+    return __libc_realloc(pointer, size);
+}
+}
+
+#endif
+
+AllocationCounter::AllocationCounter()
+    : start(threadAllocations) {
+}
+
+qint64 AllocationCounter::allocations() const {
+    return threadAllocations - start;
+}
+
+bool AllocationCounter::isAvailable() {
+#ifdef __GLIBC__
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,40 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2026 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <QtGlobal>
+
+/**
+ * Counts the heap allocations (malloc, calloc and realloc) of the current thread since the counter was created.
+ * The Qt containers allocate with malloc, so operator new alone would miss most of them. Counting is only
+ * available with glibc - the test binary replaces the allocation functions and forwards them to glibc.
+ */
+class AllocationCounter {
+public:
+    AllocationCounter();
+
+    qint64 allocations() const;
+
+    static bool isAvailable();
+
+private:
+    const qint64 start;
+};
+
+#endif // ALLOCATION_COUNTER_H
@@ -4,10 +4,22 @@ QT -= gui
 CONFIG += c++11 qt
 
 SOURCES += testmain.cpp \
-    ingdibabackendtests.cpp
+    allocationcounter.cpp \
+    ingdibabackendtests.cpp \
+    ingdibanewstests.cpp \
+    networktests.cpp \
+    securitydatatests.cpp \
+    timestamputilstests.cpp \
+    watchlistmodeltests.cpp
 
 HEADERS += \
-    ingdibabackendtests.h
+    allocationcounter.h \
+    ingdibabackendtests.h \
+    ingdibanewstests.h \
+    networktests.h \
+    securitydatatests.h \
+    timestamputilstests.h \
+    watchlistmodeltests.h
 
 INCLUDEPATH += ../../
 include(../../harbour-watchlist.pri)
@@ -18,10 +18,8 @@
 #include "ingdibabackendtests.h"
 #include <QtTest/QtTest>
 
-// TODO rename
 void IngDibaBackendTests::init() {
     ingDibaBackend = new IngDibaBackend(nullptr, nullptr);
-    ingDibaNews = new IngDibaNews(nullptr, nullptr);
 }
 
 void IngDibaBackendTests::testIngDibaUtilsConvertTimestampToLocalTimestamp() {
@@ -60,45 +58,77 @@ void IngDibaBackendTests::testIngDibaBackendProcessSearchResult() {
     QCOMPARE(resultArray.size(), 1);
 }
 
-void IngDibaBackendTests::testIngDibaNewsProcessSearchResult() {
-    QByteArray data = readFileData("ing_news.json");
-    if (data.isEmpty()) {
-        QString msg = "Testfile ing_news.json not found!";
-        QFAIL(msg.toLocal8Bit().data());
-    }
-    QString parsedResult = ingDibaNews->processSearchResult(data);
-    QJsonDocument jsonDocument = QJsonDocument::fromJson(parsedResult.toUtf8());
-    QCOMPARE(jsonDocument.isObject(), true);
+void IngDibaBackendTests::testIngDibaBackendChartMetadata() {
+    QCOMPARE(ingDibaBackend->hasChartMetadata("IE00B57X3V84"), false);
+    ingDibaBackend->storeChartMetadata("IE00B57X3V84",
+                                       "{\"valor\": \"123\", \"chartPeriods\": [\"Intraday\", \"OneYear\"]}");
+    QCOMPARE(ingDibaBackend->hasChartMetadata("IE00B57X3V84"), true);
+    QCOMPARE(ingDibaBackend->isChartPeriodAvailable("IE00B57X3V84", 1), true);   // intraday
+    QCOMPARE(ingDibaBackend->isChartPeriodAvailable("IE00B57X3V84", 16), true);  // year
+    QCOMPARE(ingDibaBackend->isChartPeriodAvailable("IE00B57X3V84", 128), false); // maximum
+    // unknown instruments are not restricted
+    QCOMPARE(ingDibaBackend->isChartPeriodAvailable("DE0005190003", 128), true);
+}
 
-    QJsonArray resultArray = jsonDocument["newsItems"].toArray();
-    QCOMPARE(resultArray.size(), 8);
+void IngDibaBackendTests::testIngDibaBackendParsePriceResponse() {
+    const QVariant result = ingDibaBackend->parsePriceResponse(
+        "{\"instruments\": [{\"data\": [[1600000000000, 10.5], [1600000060000, 12.25], [1600000120000, 11.0]]}]}");
+    QVERIFY(result.canConvert<ChartSeriesData>());
 
-    QJsonObject newsEntry = resultArray.at(0).toObject();
-    QCOMPARE(newsEntry["source"], "DJN.576664");
-    QCOMPARE(newsEntry["headline"], "Merkel-Vertraute reisen nach Washington zu Gesprächen über Nord Stream 2");
-    QCOMPARE(newsEntry["dateTime"], "Di. Juni 1 01:00:00 2021"); // TODO richtiger conversion fehlt noch
+    ChartSeries chartSeries(result.value<ChartSeriesData>());
+    QCOMPARE(chartSeries.getCount(), 3);
+    QCOMPARE(chartSeries.timestamp(0), 1600000000.0);
+    QCOMPARE(chartSeries.timestamp(2), 1600000120.0);
+    QCOMPARE(chartSeries.value(1), 12.25);
+    QCOMPARE(chartSeries.getMin(), 10.0);
+    QCOMPARE(chartSeries.getMax(), 13.0);
+    QCOMPARE(chartSeries.getFractionDigits(), 2);
+    // out of range access from qml must not crash
+    QCOMPARE(chartSeries.value(3), 0.0);
 
-    // TODO QCOMPARE first news data entry
+    QVERIFY(!ingDibaBackend->parsePriceResponse("[]").isValid());
 }
 
-void IngDibaBackendTests::testIngDibaNewsFilterContent() {
-    QString content = "<p>\n  FRANKFURT (Dow Jones)--In der deutschen  </p>\n<p>\n  Die Vereinigten Staaten .. Lage "
-                      "wünschenswert. </p>\n<p>\n  Kontakt zum Autor: unternehmen.de@dowjones.com </p>\n<p>\n  DJG/sha "
-                      "</p>\n<p>\n  (END) <a href=\"/DE/Showpage.aspx?pageID=45&ISIN=US2605661048&\" title=\"Übersicht "
-                      "Dow Jones\">Dow Jones</a> Newswires</p>\n<p>\n  July 04, 2021 11:10 ET (15:10 GMT)</p>";
-    const QString expectedContent
-        = " FRANKFURT (Dow Jones)--In der deutschen Die Vereinigten Staaten .. Lage wünschenswert. Kontakt zum Autor: "
-          "unternehmen.de@dowjones.com DJG/sha (END) Dow Jones Newswires July 04, 2021 11:10 ET (15:10 GMT) ";
-    QCOMPARE(ingDibaNews->filterContent(content), expectedContent);
-}
+void IngDibaBackendTests::testIngDibaBackendParsePriceResponseAllocations() {
+    if (!AllocationCounter::isAvailable()) {
+        QSKIP("allocations can only be counted with glibc");
+    }
 
-QByteArray IngDibaBackendTests::readFileData(const QString &fileName) {
-    QFile f("testdata/" + fileName);
-    if (!f.open(QFile::ReadOnly | QFile::Text)) {
-        QString msg = "Testfile " + fileName + " not found!";
-        return QByteArray();
+    // no allocation per point - the arrays of the series are reserved once for the whole response
+    QList<qint64> allocations;
+    foreach (int points, QList<int>() << 10 << 1000) {
+        QByteArray reply = "{\"instruments\": [{\"data\": [";
+        for (int i = 0; i < points; i++) {
+            reply += (i > 0 ? ", [" : "[") + QByteArray::number(1600000000000LL + i * 60000LL) + ", 10.25]";
+        }
+        reply += "]}]}";
+
+        AllocationCounter allocationCounter;
+        const QVariant result = ingDibaBackend->parsePriceResponse(reply);
+        const qint64 parseAllocations = allocationCounter.allocations();
+
+        QCOMPARE(result.value<ChartSeriesData>().size(), points);
+        allocations.append(parseAllocations);
     }
 
-    QTextStream in(&f);
-    return in.readAll().toUtf8();
+    QVERIFY2(allocations.at(1) == allocations.at(0),
+             qPrintable(QString("allocations for 10 / 1000 chart points : %1 / %2")
+                            .arg(allocations.at(0))
+                            .arg(allocations.at(1))));
+}
+
+void IngDibaBackendTests::testIngDibaBackendAbortReleasesCallback() {
+    QNetworkAccessManager networkAccessManager;
+    NetworkService networkService(&networkAccessManager);
+    IngDibaBackend backend(&networkService, nullptr);
+
+    networkService.beginRequestScope("page");
+    const int requestId = backend.requestPricesForChart("DE0005190003", AbstractDataBackend::INTRADAY, QJSValue());
+    networkService.endRequestScope();
+    QVERIFY(requestId != 0);
+    QCOMPARE(backend.requestCallbacks.size(), 1);
+
+    // the page is left before the chart has arrived - the callback of the page is released
+    networkService.abortRequests("page");
+    QVERIFY(backend.requestCallbacks.isEmpty());
 }
@@ -18,10 +18,13 @@
 #ifndef ING_DIBA_BACKEND_TEST_H
 #define ING_DIBA_BACKEND_TEST_H
 
+#include <QNetworkAccessManager>
 #include <QObject>
 
+#include "allocationcounter.h"
 #include "src/ingdibautils.h"
-#include "src/newsdata/ingdibanews.h"
+#include "src/network/networkservice.h"
+#include "src/securitydata/chartseries.h"
 #include "src/securitydata/ingdibabackend.h"
 
 class IngDibaBackendTests : public QObject {
@@ -29,22 +32,17 @@ class IngDibaBackendTests : public QObject {
 
 private:
     IngDibaBackend *ingDibaBackend;
-    IngDibaNews *ingDibaNews;
-
-protected:
-    QByteArray readFileData(const QString &fileName);
 
 private slots:
     void init();
 
-    // ING-DIBA Security Backend
     void testIngDibaUtilsConvertTimestampToLocalTimestamp();
     void testIngDibaBackendIsValidSecurityCategory();
     void testIngDibaBackendProcessSearchResult();
-
-    // ING-DIBA News Backend
-    void testIngDibaNewsProcessSearchResult();
-    void testIngDibaNewsFilterContent();
+    void testIngDibaBackendChartMetadata();
+    void testIngDibaBackendParsePriceResponse();
+    void testIngDibaBackendParsePriceResponseAllocations();
+    void testIngDibaBackendAbortReleasesCallback();
 };
 
 #endif // ING_DIBA_BACKEND_TEST_H
@@ -0,0 +1,44 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2020 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ING_DIBA_NEWS_TEST_H
+#define ING_DIBA_NEWS_TEST_H
+
+#include <QObject>
+
+#include "src/newsdata/ingdibanews.h"
+#include "src/newsdata/newscontentfilter.h"
+
+class IngDibaNewsTests : public QObject {
+    Q_OBJECT
+
+private:
+    IngDibaNews *ingDibaNews;
+
+protected:
+    QByteArray readFileData(const QString &fileName);
+
+private slots:
+    void init();
+
+    void testIngDibaNewsProcessSearchResult();
+    void testIngDibaNewsFilterContent();
+    void testNewsContentFilter();
+    void benchmarkNewsContentFilter();
+};
+
+#endif // ING_DIBA_NEWS_TEST_H
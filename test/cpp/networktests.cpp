@@ -0,0 +1,237 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2020 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "networktests.h"
+#include <QtTest/QtTest>
+
+void NetworkTests::testResponseCacheTimeToLive() {
+    ResponseCache responseCache;
+    QCOMPARE(responseCache.timeToLive(QUrl("https://api.euroinvestor.dk/instruments?ids=1,2,3")), 30);
+    QCOMPARE(responseCache.timeToLive(QUrl("https://api.euroinvestor.dk/instruments/11876/intradays")), 60);
+    QCOMPARE(responseCache.timeToLive(QUrl("https://api.euroinvestor.dk/instruments/11876/closeprices?fromDate=2021-01-01")),
+             3600);
+    QCOMPARE(responseCache.timeToLive(
+                 QUrl("https://component-api.wertpapiere.ing.de/api/v1/charts/shm/IE00B57X3V84?timeRange=Intraday")),
+             60);
+    QCOMPARE(responseCache.timeToLive(
+                 QUrl("https://component-api.wertpapiere.ing.de/api/v1/charts/shm/IE00B57X3V84?timeRange=OneYear")),
+             3600);
+    QCOMPARE(responseCache.timeToLive(QUrl("https://example.com/unknown")), -1);
+}
+
+void NetworkTests::testRequestSchedulerTokenBucket() {
+    TokenBucket tokenBucket(2.0, 2);
+    // bucket starts full - burst of two requests
+    QVERIFY(tokenBucket.tryConsume(0));
+    QVERIFY(tokenBucket.tryConsume(0));
+    QVERIFY(!tokenBucket.tryConsume(0));
+    QCOMPARE(tokenBucket.msecsUntilAvailable(0), 500LL);
+    // one token after 500 ms, but it is kept when reserved
+    QVERIFY(!tokenBucket.tryConsume(500, 1));
+    QVERIFY(tokenBucket.tryConsume(500));
+    // never more than the capacity
+    QVERIFY(tokenBucket.tryConsume(10000));
+    QVERIFY(tokenBucket.tryConsume(10000));
+    QVERIFY(!tokenBucket.tryConsume(10000));
+}
+
+void NetworkTests::testRetryPolicy() {
+    QCOMPARE(RetryPolicy::isRetryable(QNetworkReply::UnknownContentError, 429), true);
+    QCOMPARE(RetryPolicy::isRetryable(QNetworkReply::TimeoutError, 0), true);
+    QCOMPARE(RetryPolicy::isRetryable(QNetworkReply::ContentNotFoundError, 404), false);
+    QCOMPARE(RetryPolicy::isRetryable(QNetworkReply::NoError, 200), false);
+
+    for (int attempt = 0; attempt < MAXIMUM_RETRIES; attempt++) {
+        const int delay = RetryPolicy::backoffDelay(attempt);
+        QVERIFY(delay >= (RETRY_BASE_DELAY_MSECS << attempt) / 2);
+        QVERIFY(delay <= (RETRY_BASE_DELAY_MSECS << attempt));
+    }
+
+    const QDateTime now(QDate(2021, 3, 1), QTime(12, 0, 0), Qt::UTC);
+    QCOMPARE(RetryPolicy::retryAfterDelay("", now), -1LL);
+    QCOMPARE(RetryPolicy::retryAfterDelay("5", now), 5000LL);
+    QCOMPARE(RetryPolicy::retryAfterDelay("Mon, 01 Mar 2021 12:00:10 GMT", now), 10000LL);
+    QCOMPARE(RetryPolicy::retryAfterDelay("soon", now), -1LL);
+}
+
+void NetworkTests::testCircuitBreaker() {
+    CircuitBreaker circuitBreaker;
+    for (int i = 0; i < CIRCUIT_BREAKER_FAILURE_THRESHOLD - 1; i++) {
+        circuitBreaker.recordFailure("api.example.com", 0);
+    }
+    QCOMPARE(circuitBreaker.allowRequest("api.example.com", 0), true);
+    circuitBreaker.recordFailure("api.example.com", 0);
+    QCOMPARE(circuitBreaker.allowRequest("api.example.com", 0), false);
+    QCOMPARE(circuitBreaker.allowRequest("other.example.com", 0), true);
+
+    // single probe after the open period
+    QCOMPARE(circuitBreaker.allowRequest("api.example.com", CIRCUIT_BREAKER_OPEN_MSECS), true);
+    QCOMPARE(circuitBreaker.allowRequest("api.example.com", CIRCUIT_BREAKER_OPEN_MSECS), false);
+    circuitBreaker.recordSuccess("api.example.com");
+    QCOMPARE(circuitBreaker.allowRequest("api.example.com", CIRCUIT_BREAKER_OPEN_MSECS), true);
+}
+
+void NetworkTests::testPendingReplyAbort() {
+    PendingReply pendingReply(QUrl("https://api.example.com/quote"));
+    QSignalSpy abortSpy(&pendingReply, SIGNAL(abortRequested()));
+    QSignalSpy finishedSpy(&pendingReply, SIGNAL(finished()));
+
+    qRegisterMetaType<QNetworkReply::NetworkError>();
+    QSignalSpy errorSpy(&pendingReply, SIGNAL(error(QNetworkReply::NetworkError)));
+
+    pendingReply.abort();
+    pendingReply.abort();
+    QCOMPARE(abortSpy.count(), 1);
+
+    // the caller is told once that the request is gone - without an error to report
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(errorSpy.count(), 0);
+    QCOMPARE(pendingReply.isFinished(), true);
+    QCOMPARE(pendingReply.error(), QNetworkReply::OperationCanceledError);
+
+    // the result of an aborted reply is never delivered
+    ReplyResult replyResult;
+    replyResult.data = "{}";
+    pendingReply.complete(replyResult);
+    QCOMPARE(finishedSpy.count(), 1);
+    QVERIFY(pendingReply.readAll().isEmpty());
+}
+
+void NetworkTests::testPendingReplyDeadline() {
+    PendingReply pendingReply(QUrl("https://api.example.com/quote"));
+    QSignalSpy deadlineSpy(&pendingReply, SIGNAL(deadlineExceeded()));
+
+    // the time in the queue of the scheduler does not count
+    pendingReply.setDeadline(1);
+    QTest::qWait(20);
+    QCOMPARE(deadlineSpy.count(), 0);
+
+    pendingReply.startDeadline();
+    QTRY_COMPARE(deadlineSpy.count(), 1);
+}
+
+void NetworkTests::testTlsSessionStore() {
+    QTemporaryDir temporaryDir;
+    const QString fileName = temporaryDir.path() + "/tls_sessions.ini";
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    const QSslConfiguration baseConfiguration = QSslConfiguration::defaultConfiguration();
+
+    {
+        TlsSessionStore tlsSessionStore(fileName);
+        QVERIFY(tlsSessionStore.sslConfiguration("api.euroinvestor.dk", baseConfiguration, now).sessionTicket().isEmpty());
+        tlsSessionStore.update("api.euroinvestor.dk", "ticket", 3600, now);
+        tlsSessionStore.update("iss.moex.com", "expired", 1, now.addSecs(-60));
+        // the tickets are written together - at the latest when the store is destroyed
+        QVERIFY(tlsSessionStore.hasChanges());
+        QVERIFY(!QFile::exists(fileName));
+        tlsSessionStore.update("api.euroinvestor.dk", "ticket", 3600, now);
+        tlsSessionStore.save();
+        QVERIFY(!tlsSessionStore.hasChanges());
+        QVERIFY(QFile::exists(fileName));
+        tlsSessionStore.update("api.euroinvestor.dk", "renewed ticket", 3600, now);
+    }
+
+    // sessions survive a restart - expired sessions are dropped
+    TlsSessionStore tlsSessionStore(fileName);
+    QCOMPARE(tlsSessionStore.sslConfiguration("api.euroinvestor.dk", baseConfiguration, now).sessionTicket(),
+             QByteArray("renewed ticket"));
+    QVERIFY(tlsSessionStore.sslConfiguration("iss.moex.com", baseConfiguration, now).sessionTicket().isEmpty());
+    QVERIFY(tlsSessionStore.sslConfiguration("api.euroinvestor.dk", baseConfiguration, now.addSecs(7200))
+                .sessionTicket()
+                .isEmpty());
+}
+
+void NetworkTests::testQuoteBatcherSplitIds() {
+    const QStringList ids = QStringList() << "1234" << "5678" << "9012";
+    QCOMPARE(QuoteBatcher::splitIds(ids, 10, 100).size(), 1);
+    // prefix + "1234,5678" fits, the third id does not
+    const QList<QStringList> idLists = QuoteBatcher::splitIds(ids, 10, 19);
+    QCOMPARE(idLists.size(), 2);
+    QCOMPARE(idLists.at(0), QStringList() << "1234" << "5678");
+    QCOMPARE(idLists.at(1), QStringList() << "9012");
+    // an id that is too long on its own still gets its own request
+    QCOMPARE(QuoteBatcher::splitIds(ids, 10, 12).size(), 3);
+    QCOMPARE(QuoteBatcher::splitIds(QStringList(), 10, 100).size(), 0);
+}
+
+void NetworkTests::testQuoteBatcherSplitQuotes() {
+    // the raw json of each quote is kept - ids of nested objects are ignored
+    const QHash<QString, QByteArray> quotes = QuoteBatcher::splitQuotes(
+        "[{\"id\":1234,\"name\":\"A, B\"}, {\"exchange\":{\"id\":7},\"id\":\"X1\",\"last\":[1,2]}]");
+    QCOMPARE(quotes.size(), 2);
+    QCOMPARE(quotes.value("1234"), QByteArray("{\"id\":1234,\"name\":\"A, B\"}"));
+    QCOMPARE(quotes.value("X1"), QByteArray("{\"exchange\":{\"id\":7},\"id\":\"X1\",\"last\":[1,2]}"));
+    QVERIFY(!quotes.contains("7"));
+
+    QVERIFY(QuoteBatcher::splitQuotes("{\"error\":\"unknown\"}").isEmpty());
+}
+
+void NetworkTests::testQuoteBatcherAbortLookups() {
+    QNetworkAccessManager networkAccessManager;
+    NetworkService networkService(&networkAccessManager);
+    QuoteBatcher quoteBatcher(&networkService, "https://api.example.com/instruments?ids=");
+    quoteBatcher.setBatchWindow(0);
+
+    // the deadline of a lookup runs from the moment it is queued
+    PendingReply pendingReply(QUrl("https://api.example.com/instruments?ids=1,2"));
+    pendingReply.requestTag = "page";
+    pendingReply.setDeadline(DEFAULT_REQUEST_DEADLINE_MSECS);
+    quoteBatcher.lookup(&pendingReply, QStringList() << "1" << "2", RequestScheduler::INTERACTIVE);
+    QVERIFY(pendingReply.deadlineTimer.isActive());
+
+    // the batch request is aborted with its last lookup
+    QTRY_COMPARE(quoteBatcher.batchRequests.size(), 1);
+    quoteBatcher.abortLookups("page");
+    QCOMPARE(pendingReply.error(), QNetworkReply::OperationCanceledError);
+    QVERIFY(quoteBatcher.batchRequests.isEmpty());
+    QVERIFY(quoteBatcher.openBatches.isEmpty());
+}
+
+void NetworkTests::testResponseProcessor() {
+    ResponseProcessor responseProcessor;
+    QThread *parseThread = nullptr;
+    QString result;
+
+    responseProcessor.process(
+        "chart data",
+        [&parseThread](const QByteArray &data) {
+            parseThread = QThread::currentThread();
+            return QVariant(QString(data.toUpper()));
+        },
+        this,
+        [&result](const QVariant &parsedData) { result = parsedData.toString(); });
+
+    QTRY_COMPARE(result, QString("CHART DATA"));
+    QVERIFY(parseThread != QThread::currentThread());
+
+    // the jobs of an aborted scope are dropped and release their request, other jobs are still handled
+    bool cancelledHandled = false;
+    bool cancelledReleased = false;
+    bool otherHandled = false;
+    responseProcessor.process(
+        "chart data", [](const QByteArray &data) { return QVariant(data); }, this,
+        [&cancelledHandled](const QVariant &) { cancelledHandled = true; }, "page",
+        [&cancelledReleased]() { cancelledReleased = true; });
+    responseProcessor.process(
+        "chart data", [](const QByteArray &data) { return QVariant(data); }, this,
+        [&otherHandled](const QVariant &) { otherHandled = true; }, "other page");
+    responseProcessor.cancel("page");
+    QCOMPARE(cancelledReleased, true);
+
+    QTRY_VERIFY(otherHandled);
+    QCOMPARE(cancelledHandled, false);
+}
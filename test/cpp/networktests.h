@@ -0,0 +1,50 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2020 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NETWORK_TEST_H
+#define NETWORK_TEST_H
+
+#include <QNetworkAccessManager>
+#include <QObject>
+
+#include "src/network/networkservice.h"
+#include "src/network/pendingreply.h"
+#include "src/network/quotebatcher.h"
+#include "src/network/requestscheduler.h"
+#include "src/network/responsecache.h"
+#include "src/network/responseprocessor.h"
+#include "src/network/retrypolicy.h"
+#include "src/network/tlssessionstore.h"
+
+class NetworkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testResponseCacheTimeToLive();
+    void testRequestSchedulerTokenBucket();
+    void testRetryPolicy();
+    void testCircuitBreaker();
+    void testPendingReplyAbort();
+    void testPendingReplyDeadline();
+    void testTlsSessionStore();
+    void testQuoteBatcherSplitIds();
+    void testQuoteBatcherSplitQuotes();
+    void testQuoteBatcherAbortLookups();
+    void testResponseProcessor();
+};
+
+#endif // NETWORK_TEST_H
@@ -0,0 +1,277 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2020 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "securitydatatests.h"
+#include <QtTest/QtTest>
+
+void SecurityDataTests::testChartSeriesDataAppend() {
+    ChartSeriesData firstPage;
+    firstPage.append(1600000000000LL, 10.5);
+    firstPage.append(1600086400000LL, 12.25);
+    ChartSeriesData secondPage;
+    secondPage.append(1600172800000LL, 9.75);
+
+    // pages are appended in order - minimum and maximum cover all pages
+    ChartSeriesData chartSeriesData;
+    chartSeriesData.append(firstPage);
+    chartSeriesData.append(secondPage);
+    chartSeriesData.append(ChartSeriesData());
+
+    ChartSeries chartSeries(chartSeriesData);
+    QCOMPARE(chartSeries.getCount(), 3);
+    QCOMPARE(chartSeries.timestamp(0), 1600000000.0);
+    QCOMPARE(chartSeries.timestamp(2), 1600172800.0);
+    QCOMPARE(chartSeries.value(1), 12.25);
+    QCOMPARE(chartSeries.value(2), 9.75);
+    QVERIFY(chartSeries.getMin() <= 9.75);
+    QVERIFY(chartSeries.getMax() >= 12.25);
+}
+
+void SecurityDataTests::testIntradaySeriesCache() {
+    IntradaySeriesCache intradaySeriesCache;
+    QCOMPARE(intradaySeriesCache.lastTimestamp("DK0010274414"), 0LL);
+
+    // 2020-09-13 12:26:40 utc
+    ChartSeriesData firstFetch;
+    firstFetch.append(1600000000000LL, 10.5);
+    firstFetch.append(1600000060000LL, 11.0);
+    QCOMPARE(intradaySeriesCache.merge("DK0010274414", firstFetch), 2);
+    QCOMPARE(intradaySeriesCache.lastTimestamp("DK0010274414"), 1600000060LL);
+
+    // points that were merged already are skipped
+    ChartSeriesData refresh;
+    refresh.append(1600000060000LL, 11.0);
+    refresh.append(1600000120000LL, 12.25);
+    QCOMPARE(intradaySeriesCache.merge("DK0010274414", refresh), 1);
+    QCOMPARE(intradaySeriesCache.merge("DK0010274414", ChartSeriesData()), 0);
+
+    ChartSeries chartSeries(intradaySeriesCache.series("DK0010274414"));
+    QCOMPARE(chartSeries.getCount(), 3);
+    QCOMPARE(chartSeries.timestamp(2), 1600000120.0);
+    QCOMPARE(chartSeries.value(2), 12.25);
+
+    // the points of the next trading day replace the series
+    ChartSeriesData nextDay;
+    nextDay.append(1600086400000LL, 9.5);
+    QCOMPARE(intradaySeriesCache.merge("DK0010274414", nextDay), 1);
+    QCOMPARE(intradaySeriesCache.series("DK0010274414").size(), 1);
+    QCOMPARE(intradaySeriesCache.lastTimestamp("DK0010274414"), 1600086400LL);
+}
+
+void SecurityDataTests::testQuoteServiceGroupByBackend() {
+    IngDibaBackend ingDibaBackend(nullptr, nullptr);
+    QuoteService quoteService(nullptr);
+    quoteService.registerBackend(2, &ingDibaBackend);
+
+    // duplicates are requested once, securities of unknown backends are dropped
+    QList<QuoteRequest> quoteRequests;
+    quoteRequests << QuoteRequest{2, "DE0005190003"} << QuoteRequest{2, "IE00B57X3V84"}
+                  << QuoteRequest{2, "DE0005190003"} << QuoteRequest{0, "1234"};
+    const QHash<int, QStringList> extRefIds = quoteService.groupByBackend(quoteRequests);
+    QCOMPARE(extRefIds.size(), 1);
+    QCOMPARE(extRefIds.value(2), QStringList() << "DE0005190003" << "IE00B57X3V84");
+
+    // the ing api has no batch lookup - one batch per isin
+    const QList<QStringList> batches = ingDibaBackend.splitQuoteBatches(extRefIds.value(2));
+    QCOMPARE(batches.size(), 2);
+    QCOMPARE(batches.at(1), QStringList() << "IE00B57X3V84");
+}
+
+void SecurityDataTests::testQuoteServiceRequestId() {
+    QuoteService quoteService(nullptr);
+    QList<int> completedRequestIds;
+    connect(&quoteService,
+            &QuoteService::quoteResultsAvailable,
+            [&completedRequestIds](int requestId, const QList<QuoteResult> &quoteResults) {
+                QVERIFY(quoteResults.isEmpty());
+                completedRequestIds.append(requestId);
+            });
+
+    // nothing to request - the fetch completes after the caller got its request id
+    const int firstRequestId = quoteService.fetchQuotes(QList<QuoteRequest>() << QuoteRequest{0, "1234"},
+                                                        RequestScheduler::INTERACTIVE);
+    const int secondRequestId = quoteService.fetchQuotes(QList<QuoteRequest>(), RequestScheduler::BACKGROUND);
+    QVERIFY(firstRequestId != secondRequestId);
+    QVERIFY(completedRequestIds.isEmpty());
+
+    QTRY_COMPARE(completedRequestIds.size(), 2);
+    QCOMPARE(completedRequestIds.at(0), firstRequestId);
+    QCOMPARE(completedRequestIds.at(1), secondRequestId);
+}
+
+void SecurityDataTests::testQuoteServiceAbort() {
+    QNetworkAccessManager networkAccessManager;
+    NetworkService networkService(&networkAccessManager);
+    IngDibaBackend ingDibaBackend(&networkService, nullptr);
+    QuoteService quoteService(&networkService);
+    quoteService.registerBackend(2, &ingDibaBackend);
+    QList<int> completedRequestIds;
+    connect(&quoteService,
+            &QuoteService::quoteResultsAvailable,
+            [&completedRequestIds](int requestId, const QList<QuoteResult> &) {
+                completedRequestIds.append(requestId);
+            });
+
+    networkService.beginRequestScope("page");
+    const QList<QuoteRequest> quoteRequests = QList<QuoteRequest>()
+                                              << QuoteRequest{2, "DE0005190003"} << QuoteRequest{2, "IE00B57X3V84"};
+    quoteService.fetchQuotes(quoteRequests, RequestScheduler::INTERACTIVE);
+    networkService.endRequestScope();
+    QCOMPARE(quoteService.quoteFetches.size(), 1);
+
+    // the page is left before the quotes have arrived - the fetch is dropped without reporting it
+    networkService.abortRequests("page");
+    QVERIFY(quoteService.quoteFetches.isEmpty());
+    QTest::qWait(20);
+    QVERIFY(completedRequestIds.isEmpty());
+}
+
+void SecurityDataTests::testFieldMapper() {
+    static constexpr FieldMapping fields[] = {{"name", "SHORTNAME"}, {"price", "LCLOSEPRICE"}, {"isin", "ISIN"}};
+    static constexpr FieldMapping duplicateFields[] = {{"name", "SHORTNAME"}, {"name", "SECNAME"}};
+    static constexpr FieldMapping unknownFields[] = {{"shortName", "SHORTNAME"}};
+    static_assert(isValidMapping(fields), "valid mapping");
+    static_assert(!isValidMapping(duplicateFields), "target keys are unique");
+    static_assert(!isValidMapping(unknownFields), "target keys are result keys");
+
+    // the positions of the columns are taken from the response - SHORTNAME is missing
+    const QJsonArray columns = QJsonArray::fromStringList(QStringList() << "ISIN" << "SECID" << "LCLOSEPRICE");
+    const auto rowMapper = columnFieldMapper(fields, columns);
+    QCOMPARE(rowMapper.getMissingColumns(), QStringList() << "SHORTNAME");
+
+    QJsonArray row;
+    row.append(QString("RU0009029540"));
+    row.append(QString("SBER"));
+    row.append(271.5);
+    QJsonObject rowResult;
+    rowMapper.map(row, rowResult);
+    QCOMPARE(rowResult.size(), 2);
+    QCOMPARE(rowResult.value("isin").toString(), QString("RU0009029540"));
+    QCOMPARE(rowResult.value("price").toDouble(), 271.5);
+    QVERIFY(!rowResult.contains("name"));
+
+    static constexpr FieldMapping objectFields[] = {{"name", "text"}, {"symbol1", "wkn"}};
+    QJsonObject source;
+    source.insert("text", QString("Deutsche Bank"));
+    source.insert("wkn", QString("514000"));
+    QJsonObject objectResult;
+    objectFieldMapper(objectFields).map(source, objectResult);
+    QCOMPARE(objectResult.value("name").toString(), QString("Deutsche Bank"));
+    QCOMPARE(objectResult.value("symbol1").toString(), QString("514000"));
+}
+
+void SecurityDataTests::testJsonStreamReader() {
+    const QByteArray json = "{\"instruments\": [{\"name\": \"A \\\"B\\\" \\u00e4\", \"data\": [[1612345678000, 12.5], "
+                            "[1612345679000, -1.25e1]], \"active\": true, \"isin\": null}]}";
+
+    // the tokens must not depend on how the data is split into chunks
+    QStringList expectedTokens;
+    for (int chunkSize = json.size(); chunkSize >= 1; chunkSize--) {
+        JsonStreamReader reader;
+        QStringList tokens;
+        int offset = 0;
+        JsonStreamReader::TokenType token;
+        while ((token = reader.readNext()) != JsonStreamReader::END_OF_DATA) {
+            QVERIFY(token != JsonStreamReader::INVALID);
+            if (token == JsonStreamReader::NEED_MORE_DATA) {
+                reader.addData(json.mid(offset, chunkSize));
+                offset += chunkSize;
+                if (offset >= json.size()) {
+                    reader.finish();
+                }
+                continue;
+            }
+            QString tokenString = QString::number(token) + "@" + QString::number(reader.depth());
+            if (token == JsonStreamReader::KEY || token == JsonStreamReader::STRING) {
+                tokenString += ":" + reader.stringValue();
+            } else if (token == JsonStreamReader::NUMBER) {
+                tokenString += ":" + QString::number(reader.numberValue(), 'f', 2) + "#" + QString::number(reader.index(4));
+            }
+            tokens.append(tokenString);
+        }
+        if (expectedTokens.isEmpty()) {
+            expectedTokens = tokens;
+        }
+        QCOMPARE(tokens, expectedTokens);
+    }
+
+    QVERIFY(expectedTokens.contains(QString::number(JsonStreamReader::STRING) + "@3:A \"B\" " + QString(QChar(0xe4))));
+    QVERIFY(expectedTokens.contains(QString::number(JsonStreamReader::NUMBER) + "@5:1612345678000.00#0"));
+    QVERIFY(expectedTokens.contains(QString::number(JsonStreamReader::NUMBER) + "@5:-12.50#1"));
+
+    // misplaced separators and trailing data are rejected
+    foreach (const QByteArray &invalidJson, QList<QByteArray>() << "[1 2]" << "[1,]" << "[,1]" << "[1:2]"
+                                                                 << "{\"a\" 1}" << "{\"a\": 1,}" << "{1: 2}"
+                                                                 << "{\"a\": 1 \"b\": 2}" << "[1]x" << ",[1]"
+                                                                 << "[1] [2]") {
+        JsonStreamReader reader;
+        reader.addData(invalidJson);
+        reader.finish();
+        JsonStreamReader::TokenType token;
+        while ((token = reader.readNext()) != JsonStreamReader::END_OF_DATA && token != JsonStreamReader::INVALID) {
+        }
+        QVERIFY2(token == JsonStreamReader::INVALID, invalidJson.constData());
+    }
+}
+
+void SecurityDataTests::testJsonStreamReaderAllocations() {
+    if (!AllocationCounter::isAvailable()) {
+        QSKIP("allocations can only be counted with glibc");
+    }
+
+    // keys are shared, strings reuse the buffer and numbers are parsed in place - no allocation per element
+    QList<qint64> allocations;
+    foreach (int elements, QList<int>() << 10 << 1000) {
+        QByteArray json = "[";
+        for (int i = 0; i < elements; i++) {
+            json += (i > 0 ? ", " : "")
+                    + QByteArray("{\"timestamp\": \"2021-02-03T04:05:06Z\", \"close\": 12.5, \"active\": true, "
+                                 "\"isin\": null}");
+        }
+        json += "]";
+
+        int timestamps = 0;
+        int closeValues = 0;
+        AllocationCounter allocationCounter;
+        JsonStreamReader reader;
+        reader.addData(json);
+        reader.finish();
+        JsonStreamReader::TokenType token;
+        while ((token = reader.readNext()) != JsonStreamReader::END_OF_DATA && token != JsonStreamReader::INVALID) {
+            if (token == JsonStreamReader::STRING && reader.key(1) == QLatin1String("timestamp")) {
+                if (TimestampUtils::utcTimestampToMSecs(reader.stringValue()) == 1612325106000LL) {
+                    timestamps++;
+                }
+            } else if (token == JsonStreamReader::NUMBER && reader.key(1) == QLatin1String("close")) {
+                if (reader.numberValue() == 12.5) {
+                    closeValues++;
+                }
+            }
+        }
+        const qint64 readAllocations = allocationCounter.allocations();
+
+        QCOMPARE(token, JsonStreamReader::END_OF_DATA);
+        QCOMPARE(timestamps, elements);
+        QCOMPARE(closeValues, elements);
+        allocations.append(readAllocations);
+    }
+
+    QVERIFY2(allocations.at(1) == allocations.at(0),
+             qPrintable(QString("allocations for 10 / 1000 elements : %1 / %2")
+                            .arg(allocations.at(0))
+                            .arg(allocations.at(1))));
+}
@@ -0,0 +1,47 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2020 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SECURITY_DATA_TEST_H
+#define SECURITY_DATA_TEST_H
+
+#include <QNetworkAccessManager>
+#include <QObject>
+
+#include "allocationcounter.h"
+#include "src/timestamputils.h"
+#include "src/securitydata/backenddescriptor.h"
+#include "src/securitydata/chartseries.h"
+#include "src/securitydata/ingdibabackend.h"
+#include "src/securitydata/intradayseriescache.h"
+#include "src/securitydata/jsonstreamreader.h"
+#include "src/securitydata/quoteservice.h"
+
+class SecurityDataTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testChartSeriesDataAppend();
+    void testIntradaySeriesCache();
+    void testQuoteServiceGroupByBackend();
+    void testQuoteServiceRequestId();
+    void testQuoteServiceAbort();
+    void testFieldMapper();
+    void testJsonStreamReader();
+    void testJsonStreamReaderAllocations();
+};
+
+#endif // SECURITY_DATA_TEST_H
@@ -1,4 +1,39 @@
 #include "ingdibabackendtests.h"
+#include "ingdibanewstests.h"
+#include "networktests.h"
+#include "securitydatatests.h"
+#include "timestamputilstests.h"
+#include "watchlistmodeltests.h"
 #include <QtTest/QtTest>
 
-QTEST_GUILESS_MAIN(IngDibaBackendTests)
+// runs every test class - an output file given with -o is written per class (<class name>_<file name>)
+static int runTests(QObject *testObject, const QStringList &arguments) {
+    QStringList testArguments = arguments;
+    const int outputIndex = testArguments.indexOf("-o") + 1;
+    if (outputIndex > 0 && outputIndex < testArguments.size()) {
+        testArguments[outputIndex] = QString(testObject->metaObject()->className()) + "_"
+                                     + testArguments.at(outputIndex);
+    }
+    return QTest::qExec(testObject, testArguments);
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    const QStringList arguments = app.arguments();
+
+    IngDibaBackendTests ingDibaBackendTests;
+    IngDibaNewsTests ingDibaNewsTests;
+    NetworkTests networkTests;
+    SecurityDataTests securityDataTests;
+    TimestampUtilsTests timestampUtilsTests;
+    WatchlistModelTests watchlistModelTests;
+
+    int status = 0;
+    status |= runTests(&ingDibaBackendTests, arguments);
+    status |= runTests(&ingDibaNewsTests, arguments);
+    status |= runTests(&networkTests, arguments);
+    status |= runTests(&securityDataTests, arguments);
+    status |= runTests(&timestampUtilsTests, arguments);
+    status |= runTests(&watchlistModelTests, arguments);
+    return status;
+}
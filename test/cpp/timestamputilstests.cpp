@@ -0,0 +1,79 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2020 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "timestamputilstests.h"
+#include <QtTest/QtTest>
+
+void TimestampUtilsTests::testTimestampUtilsParseIsoDateTime() {
+    qint64 wallMSecs = 0;
+    int offsetSeconds = 0;
+    QVERIFY(TimestampUtils::parseIsoDateTime("2020-10-14T20:22:24+02:00", wallMSecs, offsetSeconds));
+    QCOMPARE(wallMSecs, QDateTime(QDate(2020, 10, 14), QTime(20, 22, 24), Qt::UTC).toMSecsSinceEpoch());
+    QCOMPARE(offsetSeconds, 7200);
+
+    QVERIFY(TimestampUtils::parseIsoDateTime("2021-02-28T09:05:01.123Z", wallMSecs, offsetSeconds));
+    QCOMPARE(wallMSecs, QDateTime(QDate(2021, 2, 28), QTime(9, 5, 1, 123), Qt::UTC).toMSecsSinceEpoch());
+    QCOMPARE(offsetSeconds, 0);
+
+    QVERIFY(TimestampUtils::parseIsoDateTime("1969-12-31 23:59:59-0130", wallMSecs, offsetSeconds));
+    QCOMPARE(wallMSecs, static_cast<qint64>(-1000));
+    QCOMPARE(offsetSeconds, -5400);
+
+    QVERIFY(TimestampUtils::parseIsoDateTime("2024-02-29", wallMSecs, offsetSeconds));
+    QCOMPARE(wallMSecs, QDateTime(QDate(2024, 2, 29), QTime(0, 0), Qt::UTC).toMSecsSinceEpoch());
+
+    QVERIFY(!TimestampUtils::parseIsoDateTime("2023-02-29", wallMSecs, offsetSeconds));
+    QVERIFY(!TimestampUtils::parseIsoDateTime("2020-10-14T25:00:00", wallMSecs, offsetSeconds));
+    QVERIFY(!TimestampUtils::parseIsoDateTime("2020-10-14T20:22:24 CET", wallMSecs, offsetSeconds));
+    QVERIFY(!TimestampUtils::parseIsoDateTime("", wallMSecs, offsetSeconds));
+    QCOMPARE(TimestampUtils::utcTimestampToMSecs("invalid"), static_cast<qint64>(0));
+}
+
+void TimestampUtilsTests::testTimeZoneOffsetCache() {
+    TimeZoneOffsetCache berlinCache(QTimeZone("Europe/Berlin"));
+    const qint64 summerTime = QDateTime(QDate(2020, 7, 1), QTime(12, 0), Qt::UTC).toMSecsSinceEpoch();
+    const qint64 winterTime = QDateTime(QDate(2020, 12, 1), QTime(12, 0), Qt::UTC).toMSecsSinceEpoch();
+    QCOMPARE(berlinCache.offsetFromUtc(summerTime), 7200);
+    QCOMPARE(berlinCache.offsetFromUtc(winterTime), 3600);
+    // served from the cached periods
+    QCOMPARE(berlinCache.offsetFromUtc(summerTime + 3600000), 7200);
+    QCOMPARE(berlinCache.offsetFromUtc(winterTime - 3600000), 3600);
+
+    // 2020-10-25 01:00 UTC - clocks were turned back from 03:00 to 02:00
+    const qint64 transition = QDateTime(QDate(2020, 10, 25), QTime(1, 0), Qt::UTC).toMSecsSinceEpoch();
+    QCOMPARE(berlinCache.offsetFromUtc(transition - 1), 7200);
+    QCOMPARE(berlinCache.offsetFromUtc(transition), 3600);
+
+    const qint64 wallTime = QDateTime(QDate(2020, 7, 1), QTime(14, 0), Qt::UTC).toMSecsSinceEpoch();
+    QCOMPARE(berlinCache.wallTimeToUtc(wallTime), summerTime);
+}
+
+void TimestampUtilsTests::benchmarkTimestampUtilsConvertToLocal() {
+    const QString timestamp("2020-10-14T20:22:24Z");
+    QBENCHMARK {
+        TimestampUtils::convertUtcToLocalDateTime(timestamp);
+    }
+}
+
+void TimestampUtilsTests::benchmarkQDateTimeConvertToLocal() {
+    // former conversion of each chart point - for comparison
+    const QString timestamp("2020-10-14T20:22:24Z");
+    QBENCHMARK {
+        QDateTime utcDateTime = QDateTime::fromString(timestamp, Qt::ISODate);
+        QDateTime(utcDateTime.date(), utcDateTime.time(), Qt::UTC).toLocalTime();
+    }
+}
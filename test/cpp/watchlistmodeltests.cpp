@@ -0,0 +1,117 @@
+/*
+ * harbour-watchlist - Sailfish OS Version
+ * Copyright © 2020 Andreas Wüst (andreas.wuest.freelancer@gmail.com)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "watchlistmodeltests.h"
+#include <QtTest/QtTest>
+
+static QVariantMap createSecurity(int id, const QString &name, double price, double changeRelative) {
+    QVariantMap security;
+    security.insert("id", id);
+    security.insert("name", name);
+    security.insert("price", price);
+    security.insert("changeRelative", changeRelative);
+    security.insert("positionCurrentValue", 100.0);
+    return security;
+}
+
+void WatchlistModelTests::testWatchlistModelUpdate() {
+    WatchlistModel watchlistModel;
+    QSignalSpy dataChangedSpy(&watchlistModel, &WatchlistModel::dataChanged);
+    QSignalSpy rowsInsertedSpy(&watchlistModel, &WatchlistModel::rowsInserted);
+    QSignalSpy rowsRemovedSpy(&watchlistModel, &WatchlistModel::rowsRemoved);
+
+    watchlistModel.update(QVariantList() << createSecurity(1, "Alpha", 10.0, 1.0) << createSecurity(2, "Beta", 30.0, -2.0));
+    QCOMPARE(watchlistModel.rowCount(), 2);
+    QCOMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(watchlistModel.getMaxChange(), 2.0);
+    QCOMPARE(watchlistModel.get(0).value("portfolioShare").toDouble(), 50.0);
+
+    // unchanged securities do not touch the rows
+    watchlistModel.update(QVariantList() << createSecurity(1, "Alpha", 10.0, 1.0) << createSecurity(2, "Beta", 30.0, -2.0));
+    QCOMPARE(dataChangedSpy.count(), 0);
+
+    // only the row with the new price is updated
+    watchlistModel.update(QVariantList() << createSecurity(1, "Alpha", 10.0, 1.0) << createSecurity(2, "Beta", 31.0, -2.0));
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.at(0).at(0).value<QModelIndex>().row(), 1);
+    QCOMPARE(watchlistModel.data(watchlistModel.index(1), watchlistModel.roleForKey("price")).toDouble(), 31.0);
+
+    // removed and added securities
+    watchlistModel.update(QVariantList() << createSecurity(2, "Beta", 31.0, -2.0) << createSecurity(3, "Gamma", 5.0, 0.5));
+    QCOMPARE(rowsRemovedSpy.count(), 1);
+    QCOMPARE(rowsInsertedSpy.count(), 2);
+    QCOMPARE(watchlistModel.get(0).value("name").toString(), QString("Beta"));
+    QCOMPARE(watchlistModel.get(1).value("name").toString(), QString("Gamma"));
+
+    watchlistModel.setValue(3, "notes", "note");
+    QCOMPARE(watchlistModel.get(1).value("notes").toString(), QString("note"));
+}
+
+void WatchlistModelTests::testWatchlistModelUpdateQuotes() {
+    WatchlistModel watchlistModel;
+    QVariantMap alpha = createSecurity(1, "Alpha", 10.0, 1.0);
+    alpha.insert("extRefId", "A1");
+    QVariantMap beta = createSecurity(2, "Beta", 30.0, -2.0);
+    beta.insert("extRefId", "B2");
+    watchlistModel.update(QVariantList() << alpha << beta);
+    QSignalSpy dataChangedSpy(&watchlistModel, &WatchlistModel::dataChanged);
+
+    // quotes are matched by extRefId - unknown securities and attributes that are no roles are ignored
+    QVariantMap betaQuote;
+    betaQuote.insert("extRefId", "B2");
+    betaQuote.insert("backendId", 0);
+    betaQuote.insert("price", 32.0);
+    betaQuote.insert("changeRelative", -4.0);
+    QVariantMap unknownQuote;
+    unknownQuote.insert("extRefId", "C3");
+    unknownQuote.insert("price", 1.0);
+    watchlistModel.updateQuotes(QVariantList() << betaQuote << unknownQuote);
+
+    QCOMPARE(watchlistModel.rowCount(), 2);
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.at(0).at(0).value<QModelIndex>().row(), 1);
+    QCOMPARE(watchlistModel.get(1).value("price").toDouble(), 32.0);
+    QCOMPARE(watchlistModel.get(1).value("id").toInt(), 2);
+    QVERIFY(!watchlistModel.get(1).contains("backendId"));
+    QCOMPARE(watchlistModel.get(0).value("price").toDouble(), 10.0);
+    QCOMPARE(watchlistModel.getMaxChange(), 4.0);
+}
+
+void WatchlistModelTests::testWatchlistSortModel() {
+    WatchlistSortModel sortModel;
+    sortModel.update(QVariantList() << createSecurity(1, "Beta", 10.0, 1.0) << createSecurity(2, "Alpha", 30.0, -2.0)
+                                    << createSecurity(3, "Gamma", 5.0, 1.0));
+    QCOMPARE(sortModel.getCount(), 3);
+
+    // default - change descending, same change sorted by name
+    QCOMPARE(sortModel.get(0).value("name").toString(), QString("Beta"));
+    QCOMPARE(sortModel.get(1).value("name").toString(), QString("Gamma"));
+    QCOMPARE(sortModel.get(2).value("name").toString(), QString("Alpha"));
+
+    // a changed price moves the row
+    sortModel.update(QVariantList() << createSecurity(1, "Beta", 10.0, 1.0) << createSecurity(2, "Alpha", 30.0, 4.0)
+                                    << createSecurity(3, "Gamma", 5.0, 1.0));
+    QCOMPARE(sortModel.get(0).value("name").toString(), QString("Alpha"));
+
+    sortModel.setSortOrder(WatchlistSortModel::SORT_BY_NAME_ASC);
+    QCOMPARE(sortModel.get(0).value("name").toString(), QString("Alpha"));
+    QCOMPARE(sortModel.get(2).value("name").toString(), QString("Gamma"));
+
+    sortModel.setSortOrder(WatchlistSortModel::SORT_BY_CHANGE_ASC);
+    QCOMPARE(sortModel.get(0).value("name").toString(), QString("Beta"));
+    QCOMPARE(sortModel.get(2).value("name").toString(), QString("Alpha"));
+}